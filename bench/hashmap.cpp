@@ -0,0 +1,106 @@
+// compare the tables in lru.hpp on int keys
+// g++ -std=c++20 -O2 -I../lru hashmap.cpp -o hashmap && ./hashmap [n]
+#include "src.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using clock_type = std::chrono::steady_clock;
+
+double since(clock_type::time_point start, size_t ops)
+{
+    return std::chrono::duration<double, std::nano>(clock_type::now() - start).count() / ops;
+}
+
+/**
+ * insert n keys, look all of them up, look up n absent keys, then remove them
+ * print the average nanoseconds of every operation
+ */
+template <class Map>
+void bench(const std::string& name, const std::vector<int>& keys)
+{
+    using value_type = sjtu::pair<int, int>;
+    size_t n = keys.size();
+    size_t found = 0;
+    Map map;
+
+    auto start = clock_type::now();
+    for (size_t i = 0; i < n; i++)
+        map.insert(value_type(keys[i], i));
+    double insert_ns = since(start, n);
+
+    start = clock_type::now();
+    for (size_t i = 0; i < n; i++)
+        found += map.find(keys[i]) != map.end();
+    double hit_ns = since(start, n);
+
+    start = clock_type::now();
+    for (size_t i = 0; i < n; i++)
+        found += map.find(keys[i] + 1) != map.end();
+    double miss_ns = since(start, n);
+
+    start = clock_type::now();
+    for (size_t i = 0; i < n; i++)
+        map.remove(keys[i]);
+    double remove_ns = since(start, n);
+
+    std::cout << name << "\tinsert " << insert_ns << "\thit " << hit_ns
+              << "\tmiss " << miss_ns << "\tremove " << remove_ns
+              << "\t(" << found << ")" << std::endl;
+}
+
+/**
+ * look up every key of a shuffled order one at a time, then in batches of 256
+ * print the average nanoseconds of every lookup
+ */
+void bench_batch(const std::vector<int>& keys)
+{
+    using map_type = sjtu::hashmap<int, int>;
+    size_t n = keys.size();
+    size_t found = 0;
+    map_type map;
+    map.reserve(n);
+    for (size_t i = 0; i < n; i++)
+        map.insert(sjtu::pair<int, int>(keys[i], i));
+    std::vector<int> order(keys);
+    std::shuffle(order.begin(), order.end(), std::mt19937(7));
+
+    auto start = clock_type::now();
+    for (size_t i = 0; i < n; i++)
+        found += map.find(order[i]) != map.end();
+    double single_ns = since(start, n);
+
+    std::vector<map_type::iterator> out(256);
+    start = clock_type::now();
+    for (size_t i = 0; i < n; i += 256) {
+        size_t m = n - i < 256 ? n - i : 256;
+        map.find_many(&order[i], m, out.data());
+        for (size_t j = 0; j < m; j++)
+            found += out[j] != map.end();
+    }
+    double batch_ns = since(start, n);
+
+    std::cout << "hashmap\tfind " << single_ns << "\tfind_many " << batch_ns
+              << "\t(" << found << ")" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    size_t n = argc > 1 ? std::atoll(argv[1]) : 1000000;
+    std::mt19937 rng(2024);
+    std::vector<int> keys(n);
+    // even keys only, so key + 1 is always a miss
+    for (size_t i = 0; i < n; i++)
+        keys[i] = (rng() >> 1) & ~1;
+    std::cout << "n = " << n << ", ns per operation" << std::endl;
+    // the chaining table runs last, its millions of small frees slow down whoever runs after it
+    bench<sjtu::robin_hashmap<int, int>>("robin", keys);
+    bench<sjtu::swiss_hashmap<int, int>>("swiss", keys);
+    bench<sjtu::hashmap<int, int>>("hashmap", keys);
+    bench_batch(keys);
+    return 0;
+}
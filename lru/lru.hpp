@@ -5,25 +5,205 @@
 #include "class-matrix.hpp"
 #include "exceptions.hpp"
 #include "utility.hpp"
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
+/**
+ * Hash and Equal are transparent:
+ * a lookup can pass a plain int, without constructing an Integer
+ */
 class Hash {
 public:
-    unsigned int operator()(Integer lhs) const
+    using is_transparent = void;
+    unsigned int operator()(const Integer& lhs) const
+    {
+        return std::hash<int>()(lhs.val);
+    }
+    unsigned int operator()(int val) const
     {
-        int val = lhs.val;
         return std::hash<int>()(val);
     }
 };
 class Equal {
 public:
+    using is_transparent = void;
     bool operator()(const Integer& lhs, const Integer& rhs) const
     {
         return lhs.val == rhs.val;
     }
+    bool operator()(const Integer& lhs, int rhs) const
+    {
+        return lhs.val == rhs;
+    }
+    bool operator()(int lhs, const Integer& rhs) const
+    {
+        return lhs == rhs.val;
+    }
 };
 
 namespace sjtu {
+/**
+ * whether both Hash and Equal declare is_transparent,
+ * then the lookups accept any key type they can hash and compare with Key
+ */
+template <class Hash, class Equal, class = void>
+struct is_transparent : std::false_type {
+};
+template <class Hash, class Equal>
+struct is_transparent<Hash, Equal, std::void_t<typename Hash::is_transparent, typename Equal::is_transparent>> : std::true_type {
+};
+/**
+ * whether a map of Key looks up by K: K is Key itself,
+ * or Hash and Equal are transparent, so no temporary Key is built
+ */
+template <class K, class Key, class Hash, class Equal>
+inline constexpr bool is_lookup_key = std::is_same_v<K, Key> || is_transparent<Hash, Equal>::value;
+
+/**
+ * fixed-size block allocator owned by a container
+ * blocks are cut from slabs (one system allocation for many blocks),
+ * and the freed blocks are recycled through a free list,
+ * so a container at a steady size never calls the system allocator
+ * all the slabs are released when the pool is released or destroyed
+ */
+template <class Block>
+class node_pool {
+public:
+    /**
+     * the cells of a slab
+     * a free cell stores the next free cell,
+     * the first cell of a slab stores the previous slab
+     */
+    union Cell {
+        Cell* nxt;
+        alignas(Block) unsigned char data[sizeof(Block)];
+    };
+    /**
+     * the number of cells of the first slab and of the largest slabs
+     * every slab is twice as large as the previous one
+     */
+    static constexpr size_t min_slab = 16;
+    static constexpr size_t max_slab = 4096;
+    /**
+     * the list of slabs and the list of free cells
+     * [bump, bump_end) is the never used part of the newest slab
+     */
+    Cell *slabs, *free_list, *bump, *bump_end;
+    size_t slab_cells;
+    /**
+     * the number of blocks handed out since the pool was created
+     * the number of slabs taken from the system allocator
+     * the number of blocks in use now
+     */
+    size_t allocations, slab_count, in_use;
+
+    node_pool()
+    {
+        slabs = free_list = bump = bump_end = nullptr;
+        slab_cells = min_slab;
+        allocations = slab_count = in_use = 0;
+    }
+    node_pool(const node_pool& other) = delete;
+    node_pool& operator=(const node_pool& other) = delete;
+    /**
+     * take over the slabs of other, which is left empty
+     */
+    node_pool(node_pool&& other) noexcept
+        : node_pool()
+    {
+        swap(other);
+    }
+    node_pool& operator=(node_pool&& other) noexcept
+    {
+        node_pool(std::move(other)).swap(*this);
+        return *this;
+    }
+    ~node_pool()
+    {
+        release();
+    }
+    void swap(node_pool& other) noexcept
+    {
+        std::swap(slabs, other.slabs);
+        std::swap(free_list, other.free_list);
+        std::swap(bump, other.bump);
+        std::swap(bump_end, other.bump_end);
+        std::swap(slab_cells, other.slab_cells);
+        std::swap(allocations, other.allocations);
+        std::swap(slab_count, other.slab_count);
+        std::swap(in_use, other.in_use);
+    }
+
+    /**
+     * return a block of memory for one Block
+     * the Block should be constructed by placement new
+     */
+    void* allocate()
+    {
+        Cell* cell;
+        if (free_list != nullptr) {
+            cell = free_list;
+            free_list = cell->nxt;
+        } else {
+            if (bump == bump_end)
+                grow();
+            cell = bump++;
+        }
+        allocations++;
+        in_use++;
+        return cell->data;
+    }
+    /**
+     * give back a block, whose Block is already destroyed
+     */
+    void deallocate(void* block)
+    {
+        Cell* cell = static_cast<Cell*>(block);
+        cell->nxt = free_list;
+        free_list = cell;
+        in_use--;
+    }
+    /**
+     * free all the slabs at once
+     * every block must be destroyed (or trivially destructible) before
+     */
+    void release()
+    {
+        while (slabs != nullptr) {
+            Cell* nxt = slabs->nxt;
+            delete[] slabs;
+            slabs = nxt;
+        }
+        free_list = bump = bump_end = nullptr;
+        slab_cells = min_slab;
+        in_use = 0;
+    }
+
+private:
+    /**
+     * take a new slab from the system allocator
+     */
+    void grow()
+    {
+        Cell* slab = new Cell[slab_cells + 1];
+        slab->nxt = slabs;
+        slabs = slab;
+        bump = slab + 1;
+        bump_end = slab + slab_cells + 1;
+        slab_count++;
+        if (slab_cells < max_slab)
+            slab_cells *= 2;
+    }
+};
+
 template <class T>
 class double_list {
 public:
@@ -39,13 +219,26 @@ public:
             , nxt(nxt)
         {
         }
-        ~Node()
+    };
+    /**
+     * a node together with its payload,
+     * allocated as one block from the pool of the list
+     */
+    struct Cell : Node {
+        T data;
+        template <class... Args>
+        Cell(Args&&... args)
+            : Node(nullptr)
+            , data(std::forward<Args>(args)...)
         {
-            if (val != nullptr)
-                delete val;
+            this->val = &this->data;
         }
     };
     Node *head, *tail;
+    /**
+     * the blocks of all the nodes except the tail
+     */
+    node_pool<Cell> pool;
 
     /**
      * constructors and destructors
@@ -81,6 +274,26 @@ public:
         }
         return *this;
     }
+    /**
+     * take over the nodes of other in O(1)
+     * other is left empty with a new tail, and can still be used
+     */
+    double_list(double_list&& other)
+        : double_list()
+    {
+        swap(other);
+    }
+    double_list& operator=(double_list&& other)
+    {
+        double_list(std::move(other)).swap(*this);
+        return *this;
+    }
+    void swap(double_list& other) noexcept
+    {
+        std::swap(head, other.head);
+        std::swap(tail, other.tail);
+        pool.swap(other.pool);
+    }
 
     /**
      * the iterator of double_list
@@ -157,7 +370,7 @@ public:
                 throw invalid_iterator();
             return *(p->val);
         }
-        T* operator->() const noexcept
+        T* operator->() const
         {
             if (p == nullptr || p->nxt == nullptr)
                 throw invalid_iterator();
@@ -228,10 +441,12 @@ public:
         Node* temp = head;
         while (temp != tail) {
             Node* temp2 = temp->nxt;
-            delete temp;
+            static_cast<Cell*>(temp)->~Cell();
             temp = temp2;
         }
         delete tail;
+        head = tail = nullptr;
+        pool.release();
         return;
     }
     /**
@@ -267,16 +482,26 @@ public:
             cur->pre->nxt = cur->nxt;
             cur->nxt->pre = cur->pre;
             pos.p = cur->nxt;
-            delete cur;
+            delete_node(cur);
             return pos;
         }
     }
     /**
      * insert an element at the head of the list
+     * copied, moved or constructed from args
      */
     void insert_head(const T& val)
     {
-        Node* cur = new Node(new T(val));
+        emplace_head(val);
+    }
+    void insert_head(T&& val)
+    {
+        emplace_head(std::move(val));
+    }
+    template <class... Args>
+    void emplace_head(Args&&... args)
+    {
+        Node* cur = new_node(std::forward<Args>(args)...);
         if (head == tail) {
             cur->nxt = head;
             cur->nxt->pre = cur;
@@ -290,10 +515,20 @@ public:
     }
     /**
      * insert an element at the tail of the list
+     * copied, moved or constructed from args
      */
     void insert_tail(const T& val)
     {
-        Node* cur = new Node(new T(val));
+        emplace_tail(val);
+    }
+    void insert_tail(T&& val)
+    {
+        emplace_tail(std::move(val));
+    }
+    template <class... Args>
+    void emplace_tail(Args&&... args)
+    {
+        Node* cur = new_node(std::forward<Args>(args)...);
         if (head == tail) {
             cur->nxt = tail;
             cur->nxt->pre = cur;
@@ -306,6 +541,29 @@ public:
         }
         return;
     }
+    /**
+     * move the element at iterator pos to the tail of the list
+     * only the links are changed, the element is not copied
+     * if the iter didn't point to anything, throw
+     */
+    void move_to_tail(iterator pos)
+    {
+        Node* cur = pos.p;
+        if (cur == nullptr || cur == tail)
+            throw invalid_iterator();
+        if (cur->nxt == tail)
+            return;
+        if (cur == head)
+            head = cur->nxt;
+        else
+            cur->pre->nxt = cur->nxt;
+        cur->nxt->pre = cur->pre;
+        cur->pre = tail->pre;
+        cur->nxt = tail;
+        tail->pre->nxt = cur;
+        tail->pre = cur;
+        return;
+    }
     /**
      * delete the head of the list
      */
@@ -316,12 +574,12 @@ public:
         Node* cur = head;
         if (cur->nxt == tail) {
             cur->nxt->pre = nullptr;
-            delete cur;
+            delete_node(cur);
             head = tail;
         } else {
             Node* tmp = cur->nxt;
             cur->nxt->pre = nullptr;
-            delete cur;
+            delete_node(cur);
             head = tmp;
         }
         return;
@@ -336,57 +594,170 @@ public:
         Node* cur = tail->pre;
         if (head->nxt == tail) {
             cur->nxt->pre = nullptr;
-            delete cur;
+            delete_node(cur);
             head = tail;
         } else {
             cur->nxt->pre = cur->pre;
             cur->pre->nxt = cur->nxt;
-            delete cur;
+            delete_node(cur);
         }
         return;
     }
+
+private:
+    /**
+     * allocate a node from the pool, its value is constructed from args
+     */
+    template <class... Args>
+    Node* new_node(Args&&... args)
+    {
+        return new (pool.allocate()) Cell(std::forward<Args>(args)...);
+    }
+    /**
+     * destroy a node and give its block back to the pool
+     */
+    void delete_node(Node* cur)
+    {
+        Cell* cell = static_cast<Cell*>(cur);
+        cell->~Cell();
+        pool.deallocate(cell);
+    }
+};
+
+/**
+ * mix the bits of a hash value,
+ * so that the low bits can index a power-of-two table
+ * (the finalizer of MurmurHash3)
+ */
+inline size_t hash_mix(size_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+/**
+ * ask the cpu to load the cache line of p ahead of its use
+ * only a hint, p may be null or dangling
+ */
+inline void prefetch(const void* p)
+{
+#if defined(__GNUC__)
+    __builtin_prefetch(p);
+#endif
+}
+
+/**
+ * the nodes of the bucket chains of hashmap
+ * the value_pair is stored inside the node,
+ * together with the mixed hash of its key,
+ * so the key is never hashed again by migrate or copy,
+ * and find compares the hashes before calling Equal
+ */
+template <class T>
+struct hash_node {
+    T val;
+    size_t hash;
+    hash_node* chain;
+    template <class... Args>
+    hash_node(size_t hash, hash_node* chain, Args&&... args)
+        : val(std::forward<Args>(args)...)
+        , hash(hash)
+        , chain(chain)
+    {
+    }
 };
 
+/**
+ * chaining hashmap
+ * Node is the type of the chain nodes, it needs the members of hash_node
+ * and may carry more (e.g. the recency links of linked_hashmap)
+ */
 template <
     class Key,
     class T,
     class Hash = std::hash<Key>,
-    class Equal = std::equal_to<Key>>
+    class Equal = std::equal_to<Key>,
+    class Node = hash_node<pair<const Key, T>>>
 class hashmap {
 public:
     using value_type = pair<const Key, T>;
-    using list = double_list<value_type>;
     /**
-     * possible size of the hashmap
+     * the minimal number of buckets
      */
-    static constexpr size_t primes[25] = { 7, 17, 31, 61, 127, 257, 509, 1021, 2053, 4093, 8191, 16381, 32771, 65537, 131071, 262147, 524287, 1048573, 2097143, 4194301, 8388617, 16777213, 33554467, 67108859 };
+    static constexpr size_t min_buckets = 8;
     /**
-     * the current capacity of the hashmap (primes[capacity])
+     * the number of keys find_many has in flight at once
+     */
+    static constexpr size_t batch = 16;
+    /**
+     * the number of buckets minus one (always a power of two minus one)
      * the current element number of the hashmap
      */
-    size_t capacity, elements;
+    size_t mask, elements;
     /**
      * the hashtable
+     * a key lives in bucket hash_mix(Hash()(key)) & mask
+     */
+    Node** table;
+    /**
+     * the table being migrated into table after an expand (old_mask + 1 buckets)
+     * nullptr if there is no migration in progress
+     * buckets of old_table before migrated are already moved
+     * lookups consult both tables during the migration
+     */
+    Node** old_table;
+    size_t old_mask, migrated;
+    /**
+     * the blocks of all the nodes
+     */
+    node_pool<Node> pool;
+    /**
+     * the least number of old buckets moved by every insert or remove
+     * 0 means the whole table is moved at once in expand and shrink
+     * step: the old buckets moved by every insert or remove
+     * in the current migration (see resize)
      */
-    list** table;
+    size_t rehash_step, step;
+    /**
+     * the max and the min average number of elements per bucket
+     * limit is the number of elements that triggers expand,
+     * (mask + 1) * max_load
+     * below low, (mask + 1) * min_load, remove halves the buckets,
+     * but never below reserved, the buckets asked for by reserve or rehash
+     */
+    float max_load, min_load;
+    size_t limit, low, reserved;
 
     /**
      *  constructors and destructors
      */
     hashmap()
     {
-        capacity = elements = 0;
-        table = new list*[primes[capacity]]();
+        mask = min_buckets - 1;
+        elements = 0;
+        table = new_buckets(mask + 1);
+        old_table = nullptr;
+        old_mask = migrated = 0;
+        rehash_step = step = 1;
+        max_load = 1.0f;
+        min_load = 0.125f;
+        reserved = min_buckets;
+        set_limits(mask + 1);
+    }
+    /**
+     * make room for n elements before the first insert
+     */
+    explicit hashmap(size_t n)
+        : hashmap()
+    {
+        reserve(n);
     }
     hashmap(const hashmap& other)
     {
-        capacity = other.capacity;
-        elements = other.elements;
-        table = new list*[primes[capacity]]();
-        for (size_t i = 0; i < primes[capacity]; i++) {
-            if (other.table[i] != nullptr)
-                table[i] = new list(*other.table[i]);
-        }
+        copy(other);
     }
     ~hashmap()
     {
@@ -397,23 +768,53 @@ public:
         if (this == &other)
             return *this;
         destroy();
-        capacity = other.capacity;
-        elements = other.elements;
-        table = new list*[primes[capacity]]();
-        for (size_t i = 0; i < primes[capacity]; i++) {
-            if (other.table[i] != nullptr)
-                table[i] = new list(*other.table[i]);
-        }
+        copy(other);
+        return *this;
+    }
+    /**
+     * take over the table and the nodes of other in O(1)
+     * other is left empty (as after destroy), and can still be used
+     */
+    hashmap(hashmap&& other) noexcept
+    {
+        rehash_step = step = 1;
+        max_load = 1.0f;
+        min_load = 0.125f;
+        reserved = min_buckets;
+        reset();
+        swap(other);
+    }
+    hashmap& operator=(hashmap&& other) noexcept
+    {
+        hashmap(std::move(other)).swap(*this);
         return *this;
     }
+    void swap(hashmap& other) noexcept
+    {
+        std::swap(mask, other.mask);
+        std::swap(elements, other.elements);
+        std::swap(table, other.table);
+        std::swap(old_table, other.old_table);
+        std::swap(old_mask, other.old_mask);
+        std::swap(migrated, other.migrated);
+        pool.swap(other.pool);
+        std::swap(rehash_step, other.rehash_step);
+        std::swap(step, other.step);
+        std::swap(max_load, other.max_load);
+        std::swap(min_load, other.min_load);
+        std::swap(limit, other.limit);
+        std::swap(low, other.low);
+        std::swap(reserved, other.reserved);
+    }
 
     /**
      * the iterator of hashmap
-     * point to the Node in every list
+     * point to the Node in every chain
+     * the nodes are never moved, so an iterator stays valid
+     * until its value_pair is removed
      */
     class iterator {
     public:
-        using Node = list::Node;
         Node* p;
         iterator(Node* p = nullptr)
             : p(p)
@@ -439,13 +840,13 @@ public:
         {
             if (p == nullptr)
                 throw invalid_iterator();
-            return *(p->val);
+            return p->val;
         }
-        value_type* operator->() const noexcept
+        value_type* operator->() const
         {
             if (p == nullptr)
                 throw invalid_iterator();
-            return p->val;
+            return &(p->val);
         }
         /**
          * other operation
@@ -478,54 +879,207 @@ public:
     }
     /**
      * destroy the whole hashmap
-     * can't be used after destroy
+     * it is left with the shared empty table,
+     * the next insert allocates a real one
      */
     void destroy()
     {
-        for (size_t i = 0; i < primes[capacity]; i++) {
-            if (table[i] != nullptr)
-                delete table[i];
+        for (size_t i = 0; i <= mask; i++)
+            destroy_chain(table[i]);
+        free_buckets(table);
+        if (old_table != nullptr) {
+            for (size_t i = migrated; i <= old_mask; i++)
+                destroy_chain(old_table[i]);
+            free_buckets(old_table);
         }
-        delete[] table;
-        capacity = elements = 0;
+        pool.release();
+        reset();
         return;
     }
     /**
      * clear the whole hashmap
-     * can be used after clear
+     * the table and the node blocks are kept for the next inserts,
+     * so refilling it does not grow it again (see shrink_to_fit)
      */
     void clear()
     {
-        destroy();
-        capacity = elements = 0;
-        table = new list*[primes[capacity]]();
+        if (old_table != nullptr) {
+            for (size_t i = migrated; i <= old_mask; i++)
+                recycle_chain(old_table[i]);
+            free_buckets(old_table);
+            old_table = nullptr;
+            old_mask = migrated = 0;
+        }
+        if (table != empty_table()) {
+            for (size_t i = 0; i <= mask; i++)
+                recycle_chain(table[i]);
+            memset(table, 0, sizeof(Node*) * (mask + 1));
+        }
+        elements = 0;
+        return;
+    }
+    /**
+     * give back the memory the elements do not need:
+     * the table is sized for the elements under max_load,
+     * and the nodes are moved into a fresh pool, so the slabs left
+     * by the removed elements are freed
+     * the capacity kept by reserve is dropped too
+     * all the iterators are invalid after that
+     */
+    void shrink_to_fit()
+    {
+        hashmap res;
+        res.rehash_step = rehash_step;
+        res.max_load = max_load;
+        res.min_load = min_load;
+        res.reserve(elements);
+        res.reserved = min_buckets;
+        migrate(old_mask + 1);
+        for (size_t i = 0; i <= mask; i++) {
+            for (Node* cur = table[i]; cur != nullptr; cur = cur->chain)
+                res.emplace_hashed(cur->val.first, cur->hash, std::move(cur->val));
+        }
+        swap(res);
         return;
     }
     /**
-     * if the capacity is lower than the number of elements, expand it
+     * if the number of elements reaches limit,
+     * double the buckets
+     * the elements are moved into the new table by later operations,
+     * step buckets at a time
      */
     void expand()
     {
-        if (capacity == 24)
-            throw index_out_of_bound();
-        list** new_table = new list*[primes[capacity + 1]]();
-        for (size_t i = 0; i < primes[capacity]; i++) {
-            if (table[i] != nullptr) {
-                for (auto [key, val] : *table[i]) {
-                    size_t pos = Hash()(key) % primes[capacity + 1];
-                    if (new_table[pos] == nullptr)
-                        new_table[pos] = new list;
-                    new_table[pos]->insert_tail(value_type(key, val));
-                }
-                delete table[i];
+        resize((mask + 1) * 2);
+        if (rehash_step == 0)
+            migrate(old_mask + 1);
+        return;
+    }
+    /**
+     * rebuild the table with at least n buckets,
+     * and enough buckets for the elements under max_load
+     * the number of buckets is rounded up to a power of two
+     * unlike expand, every element is moved at once
+     * remove does not shrink the table below it afterwards
+     */
+    void rehash(size_t n)
+    {
+        size_t need = size_t(double(elements) / max_load) + 1;
+        if (n < need)
+            n = need;
+        size_t buckets = min_buckets;
+        while (buckets < n)
+            buckets *= 2;
+        if (buckets != mask + 1)
+            resize(buckets);
+        migrate(old_mask + 1);
+        reserved = buckets;
+        return;
+    }
+    /**
+     * make room for n elements,
+     * so that no expand happens until there are more than n elements
+     */
+    void reserve(size_t n)
+    {
+        rehash(size_t(double(n) / max_load) + 1);
+        return;
+    }
+    /**
+     * return the number of buckets
+     */
+    size_t bucket_count() const
+    {
+        return mask + 1;
+    }
+    /**
+     * return the average number of elements per bucket
+     */
+    float load_factor() const
+    {
+        return float(elements) / float(mask + 1);
+    }
+    /**
+     * get or set the max average number of elements per bucket
+     * the table is only rebuilt by the next expand or rehash
+     * going below four times min_load_factor lowers it to an eighth of ml
+     */
+    float max_load_factor() const
+    {
+        return max_load;
+    }
+    void max_load_factor(float ml)
+    {
+        if (!(ml > 0))
+            throw runtime_error();
+        max_load = ml;
+        if (min_load * 4 > max_load)
+            min_load = max_load / 8;
+        if (table != empty_table())
+            set_limits(mask + 1);
+        return;
+    }
+    /**
+     * get or set the average number of elements per bucket
+     * below which remove halves the buckets, 0 never shrinks
+     * it is at most a quarter of max_load_factor,
+     * so a table just resized is far from both limits
+     * and a few inserts and removes never expand and shrink it in turn
+     */
+    float min_load_factor() const
+    {
+        return min_load;
+    }
+    void min_load_factor(float ml)
+    {
+        if (!(ml >= 0) || ml * 4 > max_load)
+            throw runtime_error();
+        min_load = ml;
+        if (table != empty_table())
+            set_limits(mask + 1);
+        return;
+    }
+    /**
+     * move n buckets of old_table into table
+     * free old_table after all the buckets are moved
+     */
+    void migrate(size_t n)
+    {
+        if (old_table == nullptr)
+            return;
+        for (; n > 0 && migrated <= old_mask; n--, migrated++) {
+            Node* cur = old_table[migrated];
+            while (cur != nullptr) {
+                Node* nxt = cur->chain;
+                size_t pos = cur->hash & mask;
+                cur->chain = table[pos];
+                table[pos] = cur;
+                cur = nxt;
             }
+            old_table[migrated] = nullptr;
+        }
+        if (migrated > old_mask) {
+            free_buckets(old_table);
+            old_table = nullptr;
         }
-        delete[] table;
-        table = new_table;
-        capacity++;
         return;
     }
 
+    /**
+     * return the mixed hash of key
+     * it can be passed to find, insert and remove
+     * so that a caller using the same key several times hashes it once
+     */
+    size_t hash(const Key& key) const
+    {
+        return hash_mix(Hash()(key));
+    }
+    template <class K, class H = Hash, std::enable_if_t<is_transparent<H, Equal>::value, int> = 0>
+    size_t hash(const K& key) const
+    {
+        return hash_mix(Hash()(key));
+    }
+
     /**
      * find the key
      * find: return a pointer point to the value
@@ -533,14 +1087,51 @@ public:
      */
     iterator find(const Key& key) const
     {
-        size_t pos = Hash()(key) % primes[capacity];
-        if (table[pos] == nullptr)
-            return end();
-        for (auto it = table[pos]->begin(); it != table[pos]->end(); it++) {
-            if (Equal()(it->first, key))
-                return iterator(it.at());
+        return find(key, hash(key));
+    }
+    template <class K, class H = Hash, std::enable_if_t<is_transparent<H, Equal>::value, int> = 0>
+    iterator find(const K& key) const
+    {
+        return find(key, hash(key));
+    }
+    template <class K, std::enable_if_t<is_lookup_key<K, Key, Hash, Equal>, int> = 0>
+    iterator find(const K& key, size_t h) const
+    {
+        return iterator(*locate(key, h));
+    }
+    /**
+     * find n keys at once, out[i] = find(keys[i])
+     * a group of batch keys is hashed and has its buckets prefetched,
+     * then its chain heads, and only then the chains are walked,
+     * so the cache misses of the independent keys overlap
+     */
+    template <class K, std::enable_if_t<is_lookup_key<K, Key, Hash, Equal>, int> = 0>
+    void find_many(const K* keys, size_t n, iterator* out) const
+    {
+        size_t h[batch];
+        for (size_t i = 0; i < n; i += batch) {
+            size_t m = n - i < batch ? n - i : batch;
+            for (size_t j = 0; j < m; j++) {
+                h[j] = hash(keys[i + j]);
+                prefetch_bucket(h[j]);
+            }
+            for (size_t j = 0; j < m; j++)
+                prefetch_chain(h[j]);
+            for (size_t j = 0; j < m; j++)
+                out[i + j] = find(keys[i + j], h[j]);
         }
-        return end();
+    }
+    /**
+     * prefetch the bucket of the mixed hash h,
+     * and the first node of its chain (read the bucket, so do it later)
+     */
+    void prefetch_bucket(size_t h) const
+    {
+        prefetch(&table[h & mask]);
+    }
+    void prefetch_chain(size_t h) const
+    {
+        prefetch(table[h & mask]);
     }
     /**
      * insert a new key
@@ -551,20 +1142,90 @@ public:
      */
     sjtu::pair<iterator, bool> insert(const value_type& value_pair)
     {
-        auto it = find(value_pair.first);
-        if (it == end()) {
-            while (elements >= primes[capacity])
-                expand();
-            size_t pos = Hash()(value_pair.first) % primes[capacity];
-            if (table[pos] == nullptr)
-                table[pos] = new list;
-            table[pos]->insert_head(value_pair);
-            elements++;
-            return sjtu::pair<iterator, bool>(iterator(table[pos]->tail->pre), true);
-        } else {
-            it->second = value_pair.second;
-            return sjtu::pair<iterator, bool>(it, false);
-        }
+        return insert(value_pair, hash(value_pair.first));
+    }
+    sjtu::pair<iterator, bool> insert(const value_type& value_pair, size_t h)
+    {
+        auto res = emplace_hashed(value_pair.first, h, value_pair);
+        if (!res.second)
+            res.first->second = value_pair.second;
+        return res;
+    }
+    sjtu::pair<iterator, bool> insert(value_type&& value_pair)
+    {
+        return insert(std::move(value_pair), hash(value_pair.first));
+    }
+    sjtu::pair<iterator, bool> insert(value_type&& value_pair, size_t h)
+    {
+        auto res = emplace_hashed(value_pair.first, h, std::move(value_pair));
+        if (!res.second)
+            res.first->second = std::move(value_pair.second);
+        return res;
+    }
+    /**
+     * construct a value_pair from args
+     * and insert it if its key is not found,
+     * otherwise leave the old value alone
+     */
+    template <class... Args>
+    sjtu::pair<iterator, bool> emplace(Args&&... args)
+    {
+        value_type value_pair(std::forward<Args>(args)...);
+        return emplace_hashed(value_pair.first, hash(value_pair.first), std::move(value_pair));
+    }
+    /**
+     * insert a value_pair with the value constructed from args
+     * only if key is not found, otherwise args are not touched
+     */
+    template <class... Args>
+    sjtu::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+    {
+        return emplace_hashed(key, hash(key), std::in_place, key, std::forward<Args>(args)...);
+    }
+    template <class... Args>
+    sjtu::pair<iterator, bool> try_emplace(Key&& key, Args&&... args)
+    {
+        return emplace_hashed(key, hash(key), std::in_place, std::move(key), std::forward<Args>(args)...);
+    }
+    /**
+     * assign obj to the value of key if it is found,
+     * otherwise insert a value_pair of key and obj
+     */
+    template <class M>
+    sjtu::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj)
+    {
+        auto res = emplace_hashed(key, hash(key), std::in_place, key, std::forward<M>(obj));
+        if (!res.second)
+            res.first->second = std::forward<M>(obj);
+        return res;
+    }
+    template <class M>
+    sjtu::pair<iterator, bool> insert_or_assign(Key&& key, M&& obj)
+    {
+        auto res = emplace_hashed(key, hash(key), std::in_place, std::move(key), std::forward<M>(obj));
+        if (!res.second)
+            res.first->second = std::forward<M>(obj);
+        return res;
+    }
+    /**
+     * insert a node whose value_pair is constructed from args,
+     * if key (whose mixed hash is h) is not found
+     * return the node of key and whether it is inserted
+     * args are only used when the node is inserted
+     */
+    template <class... Args>
+    sjtu::pair<iterator, bool> emplace_hashed(const Key& key, size_t h, Args&&... args)
+    {
+        migrate(step);
+        Node* cur = *locate(key, h);
+        if (cur != nullptr)
+            return sjtu::pair<iterator, bool>(iterator(cur), false);
+        if (elements >= limit)
+            expand();
+        size_t pos = h & mask;
+        table[pos] = new (pool.allocate()) Node(h, table[pos], std::forward<Args>(args)...);
+        elements++;
+        return sjtu::pair<iterator, bool>(iterator(table[pos]), true);
     }
     /**
      * remove a key
@@ -573,108 +1234,295 @@ public:
      */
     bool remove(const Key& key)
     {
-        auto it = find(key);
-        if (it == end())
+        return remove(key, hash(key));
+    }
+    template <class K, class H = Hash, std::enable_if_t<is_transparent<H, Equal>::value, int> = 0>
+    bool remove(const K& key)
+    {
+        return remove(key, hash(key));
+    }
+    template <class K, std::enable_if_t<is_lookup_key<K, Key, Hash, Equal>, int> = 0>
+    bool remove(const K& key, size_t h)
+    {
+        migrate(step);
+        Node** link = locate(key, h);
+        Node* cur = *link;
+        if (cur == nullptr)
             return false;
-        size_t pos = Hash()(key) % primes[capacity];
-        table[pos]->erase(typename list::iterator(it.at()));
+        *link = cur->chain;
+        cur->~Node();
+        pool.deallocate(cur);
         elements--;
+        if (elements < low && (mask + 1) / 2 >= reserved)
+            shrink();
         return true;
     }
-};
 
-template <
-    class Key,
-    class T,
-    class Hash = std::hash<Key>,
-    class Equal = std::equal_to<Key>>
-class linked_hashmap {
+private:
+    /**
+     * return the link pointing at the node of key, whose mixed hash is h
+     * not find: return the null link at the end of its chain in table
+     */
+    template <class K, std::enable_if_t<is_lookup_key<K, Key, Hash, Equal>, int> = 0>
+    Node** locate(const K& key, size_t h) const
+    {
+        if (old_table != nullptr) {
+            size_t pos = h & old_mask;
+            if (pos >= migrated) {
+                for (Node** link = &old_table[pos]; *link != nullptr; link = &(*link)->chain) {
+                    if ((*link)->hash == h && Equal()((*link)->val.first, key))
+                        return link;
+                }
+            }
+        }
+        Node** link = &table[h & mask];
+        while (*link != nullptr && ((*link)->hash != h || !Equal()((*link)->val.first, key)))
+            link = &(*link)->chain;
+        return link;
+    }
+    /**
+     * halve the buckets
+     * like expand, the elements are moved by later operations
+     */
+    void shrink()
+    {
+        resize((mask + 1) / 2);
+        if (rehash_step == 0)
+            migrate(old_mask + 1);
+        return;
+    }
+    /**
+     * swap in an empty table of n buckets,
+     * the old table becomes old_table and is migrated afterwards,
+     * step buckets by every insert or remove
+     * step is large enough to finish before the elements can reach
+     * limit or drop below low, so the next resize never finds
+     * a migration left to do at once
+     */
+    void resize(size_t n)
+    {
+        if (table == empty_table()) {
+            mask = n - 1;
+            table = new_buckets(n);
+            set_limits(n);
+            return;
+        }
+        if (old_table != nullptr)
+            migrate(old_mask + 1);
+        old_table = table;
+        old_mask = mask;
+        migrated = 0;
+        mask = n - 1;
+        table = new_buckets(n);
+        set_limits(n);
+        size_t ops = elements > low ? elements - low : 0;
+        size_t room = limit > elements ? limit - elements : 0;
+        if (room < ops)
+            ops = room;
+        step = ops > 0 ? (old_mask + ops) / ops : old_mask + 1;
+        if (step < rehash_step)
+            step = rehash_step;
+    }
+    /**
+     * set limit and low for a table of n buckets
+     * limit is at least 1
+     */
+    void set_limits(size_t n)
+    {
+        limit = size_t(double(n) * max_load);
+        if (limit == 0)
+            limit = 1;
+        low = size_t(double(n) * min_load);
+    }
+    /**
+     * the table of an empty hashmap that has not allocated its own,
+     * a single bucket shared by all of them and never written
+     * limit is 0 with it, so the first insert expands into a real table
+     */
+    static Node** empty_table()
+    {
+        static Node* bucket = nullptr;
+        return &bucket;
+    }
+    /**
+     * put the hashmap in the empty state with the shared empty table
+     * whatever it owned must be freed before
+     */
+    void reset()
+    {
+        mask = 0;
+        elements = 0;
+        table = empty_table();
+        old_table = nullptr;
+        old_mask = migrated = 0;
+        limit = low = 0;
+    }
+    static void free_buckets(Node** buckets)
+    {
+        if (buckets != empty_table())
+            free(buckets);
+    }
+    /**
+     * allocate n empty buckets
+     * calloc leaves the zeroing of a big table to the page faults,
+     * instead of touching all of it at once in expand
+     */
+    static Node** new_buckets(size_t n)
+    {
+        Node** buckets = static_cast<Node**>(calloc(n, sizeof(Node*)));
+        if (buckets == nullptr)
+            throw std::bad_alloc();
+        return buckets;
+    }
+    /**
+     * destroy every node of a chain
+     * the blocks are freed together by pool.release()
+     */
+    void destroy_chain(Node* cur)
+    {
+        while (cur != nullptr) {
+            Node* nxt = cur->chain;
+            cur->~Node();
+            cur = nxt;
+        }
+    }
+    /**
+     * destroy every node of a chain and give its block back to the pool
+     */
+    void recycle_chain(Node* cur)
+    {
+        while (cur != nullptr) {
+            Node* nxt = cur->chain;
+            cur->~Node();
+            pool.deallocate(cur);
+            cur = nxt;
+        }
+    }
+    /**
+     * copy every value_pair of other into one table of the same size
+     */
+    void copy(const hashmap& other)
+    {
+        mask = other.mask;
+        elements = other.elements;
+        rehash_step = step = other.rehash_step;
+        max_load = other.max_load;
+        min_load = other.min_load;
+        limit = other.limit;
+        low = other.low;
+        reserved = other.reserved;
+        table = new_buckets(mask + 1);
+        old_table = nullptr;
+        old_mask = migrated = 0;
+        for (size_t i = 0; i <= mask; i++)
+            copy_chain(other.table[i]);
+        if (other.old_table != nullptr) {
+            for (size_t i = other.migrated; i <= other.old_mask; i++)
+                copy_chain(other.old_table[i]);
+        }
+    }
+    void copy_chain(const Node* cur)
+    {
+        for (; cur != nullptr; cur = cur->chain) {
+            size_t pos = cur->hash & mask;
+            table[pos] = new (pool.allocate()) Node(cur->hash, table[pos], cur->val);
+        }
+    }
+};
+
+/**
+ * open-addressing hashmap with Robin Hood probing
+ * the value_pairs are stored inline in one contiguous array,
+ * and the elements of a probe run are kept sorted by their home slot,
+ * so a miss stops as soon as it meets an element richer than itself
+ * remove uses backward-shift deletion, so there is no tombstone
+ * the interface is the same as hashmap,
+ * but any insert or remove may move the elements,
+ * so all the iterators are invalid after that
+ */
+template <
+    class Key,
+    class T,
+    class Hash = std::hash<Key>,
+    class Equal = std::equal_to<Key>>
+class robin_hashmap {
 public:
     using value_type = pair<const Key, T>;
-    using list_type = double_list<value_type>;
-    using list_it = typename double_list<value_type>::iterator;
-    using map_type = hashmap<Key, list_it, Hash, Equal>;
-    using map_it = typename map_type::iterator;
     /**
-     * hashmap: store the key and the iterator to the list
-     * list: store the value_pair and the order
+     * the slots of robin_hashmap
+     * dist is the probe distance plus one, 0 means the slot is empty
      */
-    map_type map;
-    list_type list;
+    struct Slot {
+        size_t dist;
+        alignas(value_type) unsigned char data[sizeof(value_type)];
+        value_type* val()
+        {
+            return std::launder(reinterpret_cast<value_type*>(data));
+        }
+    };
+    /**
+     * the minimal number of slots
+     */
+    static constexpr size_t min_buckets = 8;
+    /**
+     * the number of slots minus one (always a power of two minus one)
+     * the current element number of the robin_hashmap
+     */
+    size_t mask, elements;
+    /**
+     * the slot array
+     */
+    Slot* table;
 
     /**
      *  constructors and destructors
      */
-    linked_hashmap() = default;
-    linked_hashmap(const linked_hashmap& other)
+    robin_hashmap()
     {
-        map = other.map;
-        list = other.list;
+        mask = min_buckets - 1;
+        elements = 0;
+        table = new Slot[mask + 1]();
     }
-    ~linked_hashmap() = default;
-    linked_hashmap& operator=(const linked_hashmap& other)
+    robin_hashmap(const robin_hashmap& other)
+    {
+        copy(other);
+    }
+    ~robin_hashmap()
+    {
+        destroy();
+    }
+    robin_hashmap& operator=(const robin_hashmap& other)
     {
         if (this == &other)
             return *this;
-        map = other.map;
-        list = other.list;
+        destroy();
+        copy(other);
         return *this;
     }
 
     /**
-     * the iterator and const_iterator of linked_hashmap
-     * point to the Node in the list
+     * the iterator of robin_hashmap
+     * point to the slot in the array
      */
-    class const_iterator;
     class iterator {
     public:
-        list_it p;
-        iterator(list_it p = list_it(nullptr))
+        Slot* p;
+        iterator(Slot* p = nullptr)
             : p(p)
         {
         }
-        iterator(const iterator& other)
+        iterator(const iterator& t)
         {
-            p = other.p;
+            p = t.p;
         }
+        iterator& operator=(const iterator& t) = default;
         ~iterator()
         {
-            p = list_it(nullptr);
-        }
-
-        /**
-         * iter++
-         */
-        iterator operator++(int)
-        {
-            iterator temp = *this;
-            p++;
-            return temp;
-        }
-        /**
-         * ++iter
-         */
-        iterator& operator++()
-        {
-            ++p;
-            return *this;
-        }
-        /**
-         * iter--
-         */
-        iterator operator--(int)
-        {
-            iterator temp = *this;
-            p--;
-            return temp;
+            p = nullptr;
         }
-        /**
-         * --iter
-         */
-        iterator& operator--()
+        Slot* at() const
         {
-            --p;
-            return *this;
+            return p;
         }
         /**
          * if the iter didn't point to a value
@@ -682,15 +1530,15 @@ public:
          */
         value_type& operator*() const
         {
-            if (p == list_it(nullptr) || (*(p.p)).val == nullptr)
+            if (p == nullptr)
                 throw invalid_iterator();
-            return *((p.p)->val);
+            return *(p->val());
         }
-        value_type* operator->() const noexcept
+        value_type* operator->() const
         {
-            if (p == list_it(nullptr) || (*(p.p)).val == nullptr)
+            if (p == nullptr)
                 throw invalid_iterator();
-            return (p.p)->val;
+            return p->val();
         }
         /**
          * other operation
@@ -703,269 +1551,3625 @@ public:
         {
             return p != rhs.p;
         }
-        bool operator==(const const_iterator& rhs) const
-        {
-            return p == rhs.p;
-        }
-        bool operator!=(const const_iterator& rhs) const
-        {
-            return p != rhs.p;
-        }
     };
-    class const_iterator {
-    public:
-        list_it p;
-        const_iterator(list_it p = list_it(nullptr))
-            : p(p)
-        {
+
+    /**
+     * return an iterator point at nothing
+     */
+    iterator end() const
+    {
+        return iterator(nullptr);
+    }
+
+    /**
+     * if didn't contain anything, return true,
+     * otherwise false
+     */
+    bool empty() const
+    {
+        return elements == 0;
+    }
+    /**
+     * destroy the whole robin_hashmap
+     * can't be used after destroy
+     */
+    void destroy()
+    {
+        for (size_t i = 0; i <= mask; i++) {
+            if (table[i].dist != 0)
+                table[i].val()->~value_type();
         }
-        const_iterator(const iterator& other)
-        {
-            p = other.p;
+        delete[] table;
+        elements = 0;
+        return;
+    }
+    /**
+     * clear the whole robin_hashmap
+     * can be used after clear
+     */
+    void clear()
+    {
+        destroy();
+        mask = min_buckets - 1;
+        table = new Slot[mask + 1]();
+        return;
+    }
+    /**
+     * if the load factor is higher than 7/8, double the slots
+     */
+    void expand()
+    {
+        Slot* old_table = table;
+        size_t old_mask = mask;
+        mask = mask * 2 + 1;
+        table = new Slot[mask + 1]();
+        for (size_t i = 0; i <= old_mask; i++) {
+            if (old_table[i].dist != 0) {
+                place(std::move(*old_table[i].val()));
+                old_table[i].val()->~value_type();
+            }
         }
-        ~const_iterator()
-        {
-            p = list_it(nullptr);
+        delete[] old_table;
+        return;
+    }
+
+    /**
+     * find the key
+     * find: return a pointer point to the value
+     * not find: return the end (point to nothing)
+     */
+    iterator find(const Key& key) const
+    {
+        size_t pos = hash_mix(Hash()(key)) & mask;
+        for (size_t dist = 1;; dist++) {
+            Slot& slot = table[pos];
+            if (slot.dist < dist)
+                return end();
+            if (Equal()(slot.val()->first, key))
+                return iterator(&slot);
+            pos = (pos + 1) & mask;
         }
-        /**
-         * iter++
-         */
-        const_iterator operator++(int)
-        {
-            const_iterator temp = *this;
-            p++;
-            return temp;
+    }
+    /**
+     * insert a new key
+     * already have a value_pair with the same key:
+     * just update the value, return false
+     * not find a value_pair with the same key:
+     * insert the value_pair, return true
+     */
+    sjtu::pair<iterator, bool> insert(const value_type& value_pair)
+    {
+        auto it = find(value_pair.first);
+        if (it == end()) {
+            if ((elements + 1) * 8 > (mask + 1) * 7)
+                expand();
+            elements++;
+            return sjtu::pair<iterator, bool>(iterator(place(value_pair)), true);
+        } else {
+            it->second = value_pair.second;
+            return sjtu::pair<iterator, bool>(it, false);
         }
-        /**
-         * ++iter
-         */
-        const_iterator& operator++()
-        {
-            ++p;
-            return *this;
+    }
+    /**
+     * remove a key
+     * the value_pair exists: remove and return true
+     * otherwise: return false
+     */
+    bool remove(const Key& key)
+    {
+        auto it = find(key);
+        if (it == end())
+            return false;
+        size_t pos = it.at() - table;
+        table[pos].val()->~value_type();
+        table[pos].dist = 0;
+        // shift the following elements back until one is at its home slot
+        size_t nxt = (pos + 1) & mask;
+        while (table[nxt].dist > 1) {
+            new (table[pos].data) value_type(std::move(*table[nxt].val()));
+            table[pos].dist = table[nxt].dist - 1;
+            table[nxt].val()->~value_type();
+            table[nxt].dist = 0;
+            pos = nxt;
+            nxt = (nxt + 1) & mask;
         }
-        /**
-         * iter--
-         */
-        const_iterator operator--(int)
-        {
-            const_iterator temp = *this;
-            p--;
-            return temp;
+        elements--;
+        return true;
+    }
+
+private:
+    /**
+     * copy the slots of other, which has the same size
+     */
+    void copy(const robin_hashmap& other)
+    {
+        mask = other.mask;
+        elements = other.elements;
+        table = new Slot[mask + 1]();
+        for (size_t i = 0; i <= mask; i++) {
+            if (other.table[i].dist != 0) {
+                new (table[i].data) value_type(*other.table[i].val());
+                table[i].dist = other.table[i].dist;
+            }
         }
-        /**
-         * --iter
-         */
-        const_iterator& operator--()
-        {
-            --p;
-            return *this;
+    }
+    /**
+     * put a value_pair whose key is not in the table yet
+     * the run after its position is shifted forward by one slot,
+     * which keeps the run sorted by home slot
+     * return the slot it is put in
+     */
+    template <class V>
+    Slot* place(V&& value_pair)
+    {
+        size_t pos = hash_mix(Hash()(value_pair.first)) & mask;
+        size_t dist = 1;
+        while (table[pos].dist >= dist) {
+            pos = (pos + 1) & mask;
+            dist++;
         }
-        /**
-         * if the iter didn't point to a value
+        size_t last = pos;
+        while (table[last].dist != 0)
+            last = (last + 1) & mask;
+        while (last != pos) {
+            size_t pre = (last - 1) & mask;
+            new (table[last].data) value_type(std::move(*table[pre].val()));
+            table[last].dist = table[pre].dist + 1;
+            table[pre].val()->~value_type();
+            last = pre;
+        }
+        new (table[pos].data) value_type(std::forward<V>(value_pair));
+        table[pos].dist = dist;
+        return &table[pos];
+    }
+};
+
+/**
+ * open-addressing hashmap probed by groups of control bytes (like Swiss table)
+ * every slot has a control byte beside it in a separate array:
+ * 	empty / deleted, or the low 7 bits of the hash (the tag) if full
+ * a probe compares the tag against 16 control bytes at once (SSE2 if available)
+ * and only calls Equal() on the slots whose tag matches,
+ * so most misses are rejected without touching any key
+ * the interface is the same as hashmap,
+ * the iterators are invalid after an insert that expands the table
+ */
+template <
+    class Key,
+    class T,
+    class Hash = std::hash<Key>,
+    class Equal = std::equal_to<Key>>
+class swiss_hashmap {
+public:
+    using value_type = pair<const Key, T>;
+    /**
+     * the slots of swiss_hashmap
+     * whether it holds a value is recorded in ctrl
+     */
+    struct Slot {
+        alignas(value_type) unsigned char data[sizeof(value_type)];
+        value_type* val()
+        {
+            return std::launder(reinterpret_cast<value_type*>(data));
+        }
+    };
+    /**
+     * the control bytes
+     * a full slot stores its tag (0 ~ 127), so the highest bit is clear
+     */
+    static constexpr signed char ctrl_empty = -128;
+    static constexpr signed char ctrl_deleted = -2;
+    /**
+     * the number of slots probed at a time
+     */
+    static constexpr size_t group_size = 16;
+    /**
+     * the number of groups minus one (always a power of two minus one)
+     * the current element number of the swiss_hashmap
+     * the number of deleted control bytes
+     */
+    size_t mask, elements, deleted;
+    /**
+     * the control bytes and the slots
+     */
+    signed char* ctrl;
+    Slot* table;
+
+    /**
+     *  constructors and destructors
+     */
+    swiss_hashmap()
+    {
+        init(1);
+    }
+    swiss_hashmap(const swiss_hashmap& other)
+    {
+        copy(other);
+    }
+    ~swiss_hashmap()
+    {
+        destroy();
+    }
+    swiss_hashmap& operator=(const swiss_hashmap& other)
+    {
+        if (this == &other)
+            return *this;
+        destroy();
+        copy(other);
+        return *this;
+    }
+
+    /**
+     * the iterator of swiss_hashmap
+     * point to the slot in the array
+     */
+    class iterator {
+    public:
+        Slot* p;
+        iterator(Slot* p = nullptr)
+            : p(p)
+        {
+        }
+        iterator(const iterator& t)
+        {
+            p = t.p;
+        }
+        iterator& operator=(const iterator& t) = default;
+        ~iterator()
+        {
+            p = nullptr;
+        }
+        Slot* at() const
+        {
+            return p;
+        }
+        /**
+         * if the iter didn't point to a value
          * throw
          */
-        const value_type& operator*() const
+        value_type& operator*() const
         {
-            if (p == list_it(nullptr) || (*(p.p)).val == nullptr)
+            if (p == nullptr)
                 throw invalid_iterator();
-            return *((p.p)->val);
+            return *(p->val());
         }
-        const value_type* operator->() const noexcept
+        value_type* operator->() const
         {
-            if (p == list_it(nullptr) || (*(p.p)).val == nullptr)
+            if (p == nullptr)
                 throw invalid_iterator();
-            return (p.p)->val;
+            return p->val();
+        }
+        /**
+         * other operation
+         */
+        bool operator==(const iterator& rhs) const
+        {
+            return p == rhs.p;
+        }
+        bool operator!=(const iterator& rhs) const
+        {
+            return p != rhs.p;
+        }
+    };
+
+    /**
+     * return an iterator point at nothing
+     */
+    iterator end() const
+    {
+        return iterator(nullptr);
+    }
+
+    /**
+     * if didn't contain anything, return true,
+     * otherwise false
+     */
+    bool empty() const
+    {
+        return elements == 0;
+    }
+    /**
+     * destroy the whole swiss_hashmap
+     * can't be used after destroy
+     */
+    void destroy()
+    {
+        size_t slots = (mask + 1) * group_size;
+        for (size_t i = 0; i < slots; i++) {
+            if (ctrl[i] >= 0)
+                table[i].val()->~value_type();
+        }
+        delete[] ctrl;
+        delete[] table;
+        elements = deleted = 0;
+        return;
+    }
+    /**
+     * clear the whole swiss_hashmap
+     * can be used after clear
+     */
+    void clear()
+    {
+        destroy();
+        init(1);
+        return;
+    }
+    /**
+     * rebuild the table with groups groups
+     * groups is rounded up to a power of two that holds all the elements
+     * also drops all the deleted control bytes
+     */
+    void rehash(size_t groups)
+    {
+        size_t need = 1;
+        while (need < groups || elements * 8 > need * group_size * 7)
+            need *= 2;
+        groups = need;
+        signed char* old_ctrl = ctrl;
+        Slot* old_table = table;
+        size_t old_slots = (mask + 1) * group_size;
+        size_t old_elements = elements;
+        init(groups);
+        elements = old_elements;
+        for (size_t i = 0; i < old_slots; i++) {
+            if (old_ctrl[i] >= 0) {
+                size_t h = hash_mix(Hash()(old_table[i].val()->first));
+                size_t pos = find_free(h);
+                new (table[pos].data) value_type(std::move(*old_table[i].val()));
+                ctrl[pos] = h & 0x7f;
+                old_table[i].val()->~value_type();
+            }
+        }
+        delete[] old_ctrl;
+        delete[] old_table;
+        return;
+    }
+
+    /**
+     * find the key
+     * find: return a pointer point to the value
+     * not find: return the end (point to nothing)
+     */
+    iterator find(const Key& key) const
+    {
+        size_t h = hash_mix(Hash()(key));
+        signed char tag = h & 0x7f;
+        size_t g = (h >> 7) & mask;
+        for (size_t step = 1;; step++) {
+            const signed char* group = ctrl + g * group_size;
+            for (unsigned bits = match(group, tag); bits != 0; bits &= bits - 1) {
+                size_t pos = g * group_size + lowest(bits);
+                if (Equal()(table[pos].val()->first, key))
+                    return iterator(table + pos);
+            }
+            if (match(group, ctrl_empty) != 0)
+                return end();
+            g = (g + step) & mask;
+        }
+    }
+    /**
+     * insert a new key
+     * already have a value_pair with the same key:
+     * just update the value, return false
+     * not find a value_pair with the same key:
+     * insert the value_pair, return true
+     */
+    sjtu::pair<iterator, bool> insert(const value_type& value_pair)
+    {
+        auto it = find(value_pair.first);
+        if (it == end()) {
+            size_t slots = (mask + 1) * group_size;
+            if ((elements + deleted + 1) * 8 > slots * 7)
+                rehash((elements + 1) * 16 > slots * 7 ? (mask + 1) * 2 : mask + 1);
+            size_t h = hash_mix(Hash()(value_pair.first));
+            size_t pos = find_free(h);
+            if (ctrl[pos] == ctrl_deleted)
+                deleted--;
+            new (table[pos].data) value_type(value_pair);
+            ctrl[pos] = h & 0x7f;
+            elements++;
+            return sjtu::pair<iterator, bool>(iterator(table + pos), true);
+        } else {
+            it->second = value_pair.second;
+            return sjtu::pair<iterator, bool>(it, false);
+        }
+    }
+    /**
+     * remove a key
+     * the value_pair exists: remove and return true
+     * otherwise: return false
+     */
+    bool remove(const Key& key)
+    {
+        auto it = find(key);
+        if (it == end())
+            return false;
+        size_t pos = it.at() - table;
+        table[pos].val()->~value_type();
+        // no probe has passed a group with an empty slot,
+        // so the slot can be empty again instead of deleted
+        if (match(ctrl + pos / group_size * group_size, ctrl_empty) != 0) {
+            ctrl[pos] = ctrl_empty;
+        } else {
+            ctrl[pos] = ctrl_deleted;
+            deleted++;
+        }
+        elements--;
+        return true;
+    }
+
+private:
+    /**
+     * return the bitmask of the control bytes in group equal to b
+     */
+    static unsigned match(const signed char* group, signed char b)
+    {
+#ifdef __SSE2__
+        __m128i ctrls = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(ctrls, _mm_set1_epi8(b)));
+#else
+        unsigned bits = 0;
+        for (size_t i = 0; i < group_size; i++)
+            bits |= unsigned(group[i] == b) << i;
+        return bits;
+#endif
+    }
+    /**
+     * return the bitmask of the empty or deleted control bytes in group
+     */
+    static unsigned match_free(const signed char* group)
+    {
+#ifdef __SSE2__
+        return _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(group)));
+#else
+        unsigned bits = 0;
+        for (size_t i = 0; i < group_size; i++)
+            bits |= unsigned(group[i] < 0) << i;
+        return bits;
+#endif
+    }
+    /**
+     * the index of the lowest set bit, bits must not be 0
+     */
+    static size_t lowest(unsigned bits)
+    {
+#ifdef __GNUC__
+        return __builtin_ctz(bits);
+#else
+        size_t i = 0;
+        for (; (bits & 1) == 0; bits >>= 1)
+            i++;
+        return i;
+#endif
+    }
+    /**
+     * return the first empty or deleted slot on the probe sequence of h
+     */
+    size_t find_free(size_t h) const
+    {
+        size_t g = (h >> 7) & mask;
+        for (size_t step = 1;; step++) {
+            unsigned bits = match_free(ctrl + g * group_size);
+            if (bits != 0)
+                return g * group_size + lowest(bits);
+            g = (g + step) & mask;
+        }
+    }
+    /**
+     * allocate an empty table with groups groups
+     */
+    void init(size_t groups)
+    {
+        mask = groups - 1;
+        elements = deleted = 0;
+        ctrl = new signed char[groups * group_size];
+        memset(ctrl, ctrl_empty, groups * group_size);
+        table = new Slot[groups * group_size];
+    }
+    /**
+     * copy the control bytes and the slots of other
+     */
+    void copy(const swiss_hashmap& other)
+    {
+        init(other.mask + 1);
+        elements = other.elements;
+        deleted = other.deleted;
+        size_t slots = (mask + 1) * group_size;
+        memcpy(ctrl, other.ctrl, slots);
+        for (size_t i = 0; i < slots; i++) {
+            if (ctrl[i] >= 0)
+                new (table[i].data) value_type(*other.table[i].val());
+        }
+    }
+};
+
+template <
+    class Key,
+    class T,
+    class Hash = std::hash<Key>,
+    class Equal = std::equal_to<Key>>
+class linked_hashmap {
+public:
+    using value_type = pair<const Key, T>;
+    /**
+     * the recency links, the tail of the list is a bare Link
+     */
+    struct Link {
+        Link *pre, *nxt;
+        Link(Link* pre = nullptr, Link* nxt = nullptr)
+            : pre(pre)
+            , nxt(nxt)
+        {
+        }
+    };
+    /**
+     * the nodes of linked_hashmap
+     * one allocation carries the value_pair, its hash, the hash chain link
+     * and the recency links
+     */
+    struct Node : Link {
+        value_type val;
+        size_t hash;
+        Node* chain;
+        template <class... Args>
+        Node(size_t hash, Node* chain, Args&&... args)
+            : val(std::forward<Args>(args)...)
+            , hash(hash)
+            , chain(chain)
+        {
+        }
+    };
+    using map_type = hashmap<Key, T, Hash, Equal, Node>;
+    using map_it = typename map_type::iterator;
+    /**
+     * the number of keys find_many has in flight at once
+     */
+    static constexpr size_t batch = map_type::batch;
+    /**
+     * hashmap: own the nodes and find them by key
+     * head, tail: the order of the nodes,
+     * here we denote tail as a node points to nothing
+     */
+    map_type map;
+    Link* head;
+    Link tail;
+
+    /**
+     *  constructors and destructors
+     */
+    linked_hashmap()
+    {
+        head = &tail;
+    }
+    linked_hashmap(const linked_hashmap& other)
+    {
+        head = &tail;
+        copy(other);
+    }
+    ~linked_hashmap() = default;
+    linked_hashmap& operator=(const linked_hashmap& other)
+    {
+        if (this == &other)
+            return *this;
+        clear();
+        copy(other);
+        return *this;
+    }
+    /**
+     * take over the nodes of other in O(1)
+     * only the links to the tail are redirected, the nodes stay put
+     * other is left empty, and can still be used
+     */
+    linked_hashmap(linked_hashmap&& other) noexcept
+        : map(std::move(other.map))
+    {
+        head = other.head;
+        tail.pre = other.tail.pre;
+        attach_tail();
+        other.head = &other.tail;
+        other.tail.pre = nullptr;
+    }
+    linked_hashmap& operator=(linked_hashmap&& other) noexcept
+    {
+        linked_hashmap(std::move(other)).swap(*this);
+        return *this;
+    }
+    void swap(linked_hashmap& other) noexcept
+    {
+        map.swap(other.map);
+        std::swap(head, other.head);
+        std::swap(tail.pre, other.tail.pre);
+        attach_tail();
+        other.attach_tail();
+    }
+
+    /**
+     * the iterator and const_iterator of linked_hashmap
+     * point to the Node in the list
+     */
+    class const_iterator;
+    class iterator {
+    public:
+        Link* p;
+        iterator(Link* p = nullptr)
+            : p(p)
+        {
+        }
+        iterator(const iterator& other)
+        {
+            p = other.p;
+        }
+        iterator& operator=(const iterator& other) = default;
+        ~iterator()
+        {
+            p = nullptr;
+        }
+
+        /**
+         * iter++
+         */
+        iterator operator++(int)
+        {
+            iterator temp = *this;
+            ++*this;
+            return temp;
+        }
+        /**
+         * ++iter
+         */
+        iterator& operator++()
+        {
+            if (p == nullptr || p->nxt == nullptr)
+                throw invalid_iterator();
+            p = p->nxt;
+            return *this;
+        }
+        /**
+         * iter--
+         */
+        iterator operator--(int)
+        {
+            iterator temp = *this;
+            --*this;
+            return temp;
+        }
+        /**
+         * --iter
+         */
+        iterator& operator--()
+        {
+            if (p == nullptr || p->pre == nullptr)
+                throw invalid_iterator();
+            p = p->pre;
+            return *this;
+        }
+        /**
+         * if the iter didn't point to a value
+         * throw
+         */
+        value_type& operator*() const
+        {
+            if (p == nullptr || p->nxt == nullptr)
+                throw invalid_iterator();
+            return static_cast<Node*>(p)->val;
+        }
+        value_type* operator->() const
+        {
+            if (p == nullptr || p->nxt == nullptr)
+                throw invalid_iterator();
+            return &(static_cast<Node*>(p)->val);
+        }
+        /**
+         * other operation
+         */
+        bool operator==(const iterator& rhs) const
+        {
+            return p == rhs.p;
+        }
+        bool operator!=(const iterator& rhs) const
+        {
+            return p != rhs.p;
+        }
+        bool operator==(const const_iterator& rhs) const
+        {
+            return p == rhs.p;
+        }
+        bool operator!=(const const_iterator& rhs) const
+        {
+            return p != rhs.p;
+        }
+    };
+    class const_iterator {
+    public:
+        const Link* p;
+        const_iterator(const Link* p = nullptr)
+            : p(p)
+        {
+        }
+        const_iterator(const iterator& other)
+        {
+            p = other.p;
+        }
+        const_iterator(const const_iterator& other) = default;
+        const_iterator& operator=(const const_iterator& other) = default;
+        ~const_iterator()
+        {
+            p = nullptr;
+        }
+        /**
+         * iter++
+         */
+        const_iterator operator++(int)
+        {
+            const_iterator temp = *this;
+            ++*this;
+            return temp;
+        }
+        /**
+         * ++iter
+         */
+        const_iterator& operator++()
+        {
+            if (p == nullptr || p->nxt == nullptr)
+                throw invalid_iterator();
+            p = p->nxt;
+            return *this;
+        }
+        /**
+         * iter--
+         */
+        const_iterator operator--(int)
+        {
+            const_iterator temp = *this;
+            --*this;
+            return temp;
+        }
+        /**
+         * --iter
+         */
+        const_iterator& operator--()
+        {
+            if (p == nullptr || p->pre == nullptr)
+                throw invalid_iterator();
+            p = p->pre;
+            return *this;
+        }
+        /**
+         * if the iter didn't point to a value
+         * throw
+         */
+        const value_type& operator*() const
+        {
+            if (p == nullptr || p->nxt == nullptr)
+                throw invalid_iterator();
+            return static_cast<const Node*>(p)->val;
+        }
+        const value_type* operator->() const
+        {
+            if (p == nullptr || p->nxt == nullptr)
+                throw invalid_iterator();
+            return &(static_cast<const Node*>(p)->val);
+        }
+        /**
+         * other operation
+         */
+        bool operator==(const iterator& rhs) const
+        {
+            return p == rhs.p;
+        }
+        bool operator!=(const iterator& rhs) const
+        {
+            return p != rhs.p;
+        }
+        bool operator==(const const_iterator& rhs) const
+        {
+            return p == rhs.p;
+        }
+        bool operator!=(const const_iterator& rhs) const
+        {
+            return p != rhs.p;
+        }
+    };
+
+    /**
+     * return the value connected with the key
+     * if the key not found, throw
+     */
+    T& at(const Key& key)
+    {
+        map_it it = map.find(key);
+        if (it == map.end())
+            throw index_out_of_bound();
+        return it->second;
+    }
+    const T& at(const Key& key) const
+    {
+        map_it it = map.find(key);
+        if (it == map.end())
+            throw index_out_of_bound();
+        return it->second;
+    }
+    template <class K, class H = Hash, std::enable_if_t<is_transparent<H, Equal>::value, int> = 0>
+    T& at(const K& key)
+    {
+        map_it it = map.find(key);
+        if (it == map.end())
+            throw index_out_of_bound();
+        return it->second;
+    }
+    template <class K, class H = Hash, std::enable_if_t<is_transparent<H, Equal>::value, int> = 0>
+    const T& at(const K& key) const
+    {
+        map_it it = map.find(key);
+        if (it == map.end())
+            throw index_out_of_bound();
+        return it->second;
+    }
+    T& operator[](const Key& key)
+    {
+        return at(key);
+    }
+    const T& operator[](const Key& key) const
+    {
+        return at(key);
+    }
+
+    /**
+     * return an iterator point at the beginning
+     * const or not
+     */
+    iterator begin()
+    {
+        return iterator(head);
+    }
+    const_iterator cbegin() const
+    {
+        return const_iterator(head);
+    }
+    /**
+     * return an iterator point at the ending
+     * const or not
+     */
+    iterator end()
+    {
+        return iterator(&tail);
+    }
+    const_iterator cend() const
+    {
+        return const_iterator(&tail);
+    }
+
+    /**
+     * if didn't contain anything, return true,
+     * otherwise false.
+     */
+    bool empty() const
+    {
+        return map.empty();
+    }
+    /**
+     * destroy the whole linked_hashmap
+     * it is left empty, see hashmap::destroy
+     */
+    void destroy()
+    {
+        map.destroy();
+        head = &tail;
+        tail.pre = nullptr;
+        return;
+    }
+    /**
+     * clear the whole linked_hashmap
+     * the index and the node blocks are kept, see hashmap::clear
+     */
+    void clear()
+    {
+        map.clear();
+        head = &tail;
+        tail.pre = nullptr;
+        return;
+    }
+    /**
+     * give back the memory the value_pairs do not need
+     * the nodes are moved into a fresh map in the order of the list,
+     * see hashmap::shrink_to_fit
+     * all the iterators are invalid after that
+     */
+    void shrink_to_fit()
+    {
+        linked_hashmap res;
+        res.map.rehash_step = map.rehash_step;
+        res.map.max_load_factor(map.max_load_factor());
+        res.map.min_load_factor(map.min_load_factor());
+        res.map.reserve(size());
+        for (Link* cur = head; cur != &tail; cur = cur->nxt) {
+            Node* node = static_cast<Node*>(cur);
+            res.relink(res.map.emplace_hashed(node->val.first, node->hash, std::move(node->val)), false);
+        }
+        swap(res);
+        return;
+    }
+    /**
+     * return the number of value_pairs
+     */
+    size_t size() const
+    {
+        return map.elements;
+    }
+    /**
+     * make room for n value_pairs, see hashmap::reserve
+     */
+    void reserve(size_t n)
+    {
+        map.reserve(n);
+        return;
+    }
+    /**
+     * rebuild the index with at least n buckets, see hashmap::rehash
+     */
+    void rehash(size_t n)
+    {
+        map.rehash(n);
+        return;
+    }
+    size_t bucket_count() const
+    {
+        return map.bucket_count();
+    }
+    float load_factor() const
+    {
+        return map.load_factor();
+    }
+    float max_load_factor() const
+    {
+        return map.max_load_factor();
+    }
+    void max_load_factor(float ml)
+    {
+        map.max_load_factor(ml);
+        return;
+    }
+    float min_load_factor() const
+    {
+        return map.min_load_factor();
+    }
+    void min_load_factor(float ml)
+    {
+        map.min_load_factor(ml);
+        return;
+    }
+
+    /**
+     * find the iterator points at the value_pair
+     * which consist of key
+     * if not find, return an iterator
+     * point at nothing
+     */
+    iterator find(const Key& key)
+    {
+        return find(key, map.hash(key));
+    }
+    template <class K, class H = Hash, std::enable_if_t<is_transparent<H, Equal>::value, int> = 0>
+    iterator find(const K& key)
+    {
+        return find(key, map.hash(key));
+    }
+    /**
+     * find with the mixed hash h of key computed ahead by hash(key)
+     */
+    template <class K, std::enable_if_t<is_lookup_key<K, Key, Hash, Equal>, int> = 0>
+    iterator find(const K& key, size_t h)
+    {
+        map_it it = map.find(key, h);
+        if (it == map.end())
+            return end();
+        return iterator(it.at());
+    }
+    /**
+     * find n keys at once, out[i] = find(keys[i])
+     * see hashmap::find_many
+     */
+    template <class K, std::enable_if_t<is_lookup_key<K, Key, Hash, Equal>, int> = 0>
+    void find_many(const K* keys, size_t n, iterator* out)
+    {
+        map_it res[batch];
+        for (size_t i = 0; i < n; i += batch) {
+            size_t m = n - i < batch ? n - i : batch;
+            map.find_many(keys + i, m, res);
+            for (size_t j = 0; j < m; j++)
+                out[i + j] = res[j] == map.end() ? end() : iterator(res[j].at());
+        }
+    }
+    /**
+     * prefetch the index of the mixed hash h, see hashmap::prefetch_bucket
+     */
+    void prefetch_bucket(size_t h) const
+    {
+        map.prefetch_bucket(h);
+    }
+    void prefetch_chain(size_t h) const
+    {
+        map.prefetch_chain(h);
+    }
+    /**
+     * return the mixed hash of key, see find(key, h) and touch(key, h)
+     */
+    size_t hash(const Key& key) const
+    {
+        return map.hash(key);
+    }
+    template <class K, class H = Hash, std::enable_if_t<is_transparent<H, Equal>::value, int> = 0>
+    size_t hash(const K& key) const
+    {
+        return map.hash(key);
+    }
+    /**
+     * return how many value_pairs consist of the key
+     * should only return 0 or 1
+     */
+    size_t count(const Key& key) const
+    {
+        return map.find(key) != map.end();
+    }
+    template <class K, class H = Hash, std::enable_if_t<is_transparent<H, Equal>::value, int> = 0>
+    size_t count(const K& key) const
+    {
+        return map.find(key) != map.end();
+    }
+    /**
+     * insert a new key
+     * already have a value_pair with the same key:
+     * just update the value, return false
+     * and move the value_pair to the end of the list
+     * not find a value_pair with the same key:
+     * insert the value_pair, return true
+     */
+    pair<iterator, bool> insert(const value_type& value)
+    {
+        return relink(map.insert(value), true);
+    }
+    pair<iterator, bool> insert(value_type&& value)
+    {
+        return relink(map.insert(std::move(value)), true);
+    }
+    pair<iterator, bool> insert(const value_type& value, size_t h)
+    {
+        return relink(map.insert(value, h), true);
+    }
+    pair<iterator, bool> insert(value_type&& value, size_t h)
+    {
+        return relink(map.insert(std::move(value), h), true);
+    }
+    /**
+     * emplace and try_emplace leave a found value_pair unchanged
+     * and where it is in the list
+     * insert_or_assign is insert with the value given apart
+     */
+    template <class... Args>
+    pair<iterator, bool> emplace(Args&&... args)
+    {
+        return relink(map.emplace(std::forward<Args>(args)...), false);
+    }
+    template <class... Args>
+    pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+    {
+        return relink(map.try_emplace(key, std::forward<Args>(args)...), false);
+    }
+    template <class... Args>
+    pair<iterator, bool> try_emplace(Key&& key, Args&&... args)
+    {
+        return relink(map.try_emplace(std::move(key), std::forward<Args>(args)...), false);
+    }
+    template <class M>
+    pair<iterator, bool> insert_or_assign(const Key& key, M&& obj)
+    {
+        return relink(map.insert_or_assign(key, std::forward<M>(obj)), true);
+    }
+    template <class M>
+    pair<iterator, bool> insert_or_assign(Key&& key, M&& obj)
+    {
+        return relink(map.insert_or_assign(std::move(key), std::forward<M>(obj)), true);
+    }
+    /**
+     * emplace with the mixed hash h of key computed ahead by hash(key)
+     * see hashmap::emplace_hashed
+     */
+    template <class... Args>
+    pair<iterator, bool> emplace_hashed(const Key& key, size_t h, Args&&... args)
+    {
+        return relink(map.emplace_hashed(key, h, std::forward<Args>(args)...), false);
+    }
+    /**
+     * move the value_pair at iterator pos to the end of the list
+     * only the links are changed, nothing is copied or reallocated
+     * if the iter didn't point to anything, throw
+     */
+    void move_to_back(iterator pos)
+    {
+        if (pos.p == nullptr || pos.p == &tail)
+            throw invalid_iterator();
+        Node* cur = static_cast<Node*>(pos.p);
+        if (cur->nxt != &tail) {
+            unlink(cur);
+            link_tail(cur);
+        }
+        return;
+    }
+    /**
+     * move the value_pair of key to the end of the list
+     * return the iterator points at it, or end() if not find
+     */
+    iterator touch(const Key& key)
+    {
+        return touch(key, map.hash(key));
+    }
+    template <class K, class H = Hash, std::enable_if_t<is_transparent<H, Equal>::value, int> = 0>
+    iterator touch(const K& key)
+    {
+        return touch(key, map.hash(key));
+    }
+    template <class K, std::enable_if_t<is_lookup_key<K, Key, Hash, Equal>, int> = 0>
+    iterator touch(const K& key, size_t h)
+    {
+        iterator it = find(key, h);
+        if (it != end())
+            move_to_back(it);
+        return it;
+    }
+    /**
+     * erase the element at iterator pos
+     * if the iter didn't point to anything, throw
+     */
+    void remove(iterator pos)
+    {
+        if (pos.p == nullptr || pos.p == &tail)
+            throw invalid_iterator();
+        Node* cur = static_cast<Node*>(pos.p);
+        unlink(cur);
+        map.remove(cur->val.first, cur->hash);
+        return;
+    }
+
+private:
+    /**
+     * put the node returned by map at the end of the list
+     * if it is new or updated is true
+     */
+    pair<iterator, bool> relink(sjtu::pair<map_it, bool> res, bool updated)
+    {
+        Node* cur = res.first.at();
+        if (res.second) {
+            link_tail(cur);
+        } else if (updated) {
+            unlink(cur);
+            link_tail(cur);
+        }
+        return sjtu::pair<iterator, bool>(iterator(cur), res.second);
+    }
+    /**
+     * put a node at the end of the list
+     */
+    void link_tail(Node* cur)
+    {
+        cur->nxt = &tail;
+        cur->pre = tail.pre;
+        if (tail.pre != nullptr)
+            tail.pre->nxt = cur;
+        else
+            head = cur;
+        tail.pre = cur;
+    }
+    /**
+     * point the list taken from another linked_hashmap
+     * (head and tail.pre) at our own tail
+     */
+    void attach_tail()
+    {
+        if (tail.pre != nullptr)
+            tail.pre->nxt = &tail;
+        else
+            head = &tail;
+    }
+    /**
+     * take a node out of the list
+     */
+    void unlink(Node* cur)
+    {
+        if (cur->pre != nullptr)
+            cur->pre->nxt = cur->nxt;
+        else
+            head = cur->nxt;
+        cur->nxt->pre = cur->pre;
+    }
+    /**
+     * insert every value_pair of other in its order
+     */
+    void copy(const linked_hashmap& other)
+    {
+        for (const Link* cur = other.head; cur != &other.tail; cur = cur->nxt)
+            insert(static_cast<const Node*>(cur)->val);
+    }
+};
+
+/**
+ * linked_hashmap keeping all the entries in one arena
+ * the entries are linked by 32-bit indices into the arena
+ * (the hash chains, the order and the free slots),
+ * so the link overhead of an entry is 12 bytes plus a 32-bit hash
+ * the arena grows by chunks of chunk_size entries, so an entry never moves
+ * and a traversal of a map without many removes walks sequential memory
+ * a copy is a copy-on-write snapshot: it shares the chunks of the arena
+ * and the pages of the buckets, and a map copies one only when writing to it
+ * the interface is the same as linked_hashmap
+ */
+template <
+    class Key,
+    class T,
+    class Hash = std::hash<Key>,
+    class Equal = std::equal_to<Key>>
+class compact_linked_hashmap {
+public:
+    using value_type = pair<const Key, T>;
+    using index = unsigned int;
+    /**
+     * the index pointing to nothing
+     * vacant: the pre of an entry holding no value_pair
+     * (a free entry, or one never taken from the arena)
+     */
+    static constexpr index nil = ~index(0);
+    static constexpr index vacant = nil - 1;
+    /**
+     * the entries of the arena
+     * hash is the low 32 bits of the mixed hash of the key
+     * pre / nxt: the order, chain: the next entry of the same bucket
+     * a free entry is on the free-slot stack through nxt
+     */
+    struct Entry {
+        alignas(value_type) unsigned char data[sizeof(value_type)];
+        index hash, chain, pre, nxt;
+        value_type* val()
+        {
+            return std::launder(reinterpret_cast<value_type*>(data));
+        }
+        const value_type* val() const
+        {
+            return std::launder(reinterpret_cast<const value_type*>(data));
+        }
+    };
+    /**
+     * the number of entries of a chunk and of buckets of a page (1 << chunk_bits)
+     */
+    static constexpr size_t chunk_bits = 10;
+    static constexpr size_t chunk_size = size_t(1) << chunk_bits;
+    /**
+     * the chunks of the arena and the pages of the buckets
+     * refs is the number of maps sharing one,
+     * a map writing to a shared one copies it first
+     * (see write_entry and write_bucket)
+     */
+    struct Chunk {
+        std::atomic<size_t> refs;
+        Entry entries[chunk_size];
+        Chunk()
+            : refs(1)
+        {
+            for (size_t k = 0; k < chunk_size; k++)
+                entries[k].pre = vacant;
+        }
+    };
+    struct Page {
+        std::atomic<size_t> refs;
+        index slots[chunk_size];
+        Page()
+            : refs(1)
+        {
+            for (size_t k = 0; k < chunk_size; k++)
+                slots[k] = nil;
+        }
+    };
+    /**
+     * the minimal number of buckets
+     */
+    static constexpr size_t min_buckets = 8;
+    /**
+     * the chunks of the arena, chunk_count of chunk_capacity are allocated
+     * used: the number of entries ever taken from the arena
+     * free_head: the top of the free-slot stack
+     */
+    Chunk** chunks;
+    size_t chunk_count, chunk_capacity, used;
+    index free_head;
+    /**
+     * the pages of the buckets, mask + 1 buckets (always a power of two)
+     * the current element number of the map
+     */
+    Page** pages;
+    size_t mask, elements;
+    /**
+     * the first and the last entry of the order
+     */
+    index head, tail;
+
+    /**
+     *  constructors and destructors
+     */
+    compact_linked_hashmap()
+    {
+        init();
+    }
+    /**
+     * take a snapshot of other in O(n / chunk_size)
+     * nothing is copied until one of the maps writes
+     * (insert, remove, modify or a promotion), which copies only
+     * the chunks and pages it touches, the reads never copy
+     * (a rehash rewrites every entry, so it copies all the shared chunks)
+     * the snapshot can be read and destroyed by another thread
+     * while other keeps being written
+     */
+    compact_linked_hashmap(const compact_linked_hashmap& other)
+    {
+        share(other);
+    }
+    ~compact_linked_hashmap()
+    {
+        destroy();
+    }
+    compact_linked_hashmap& operator=(const compact_linked_hashmap& other)
+    {
+        if (this == &other)
+            return *this;
+        destroy();
+        share(other);
+        return *this;
+    }
+
+    /**
+     * the iterator and const_iterator of compact_linked_hashmap
+     * the map and the index of the entry, nil for the end
+     */
+    class const_iterator;
+    class iterator {
+    public:
+        compact_linked_hashmap* map;
+        index i;
+        iterator(compact_linked_hashmap* map = nullptr, index i = nil)
+            : map(map)
+            , i(i)
+        {
+        }
+        iterator(const iterator& other) = default;
+        iterator& operator=(const iterator& other) = default;
+        /**
+         * iter++
+         */
+        iterator operator++(int)
+        {
+            iterator temp = *this;
+            ++*this;
+            return temp;
+        }
+        /**
+         * ++iter
+         */
+        iterator& operator++()
+        {
+            if (map == nullptr || i == nil)
+                throw invalid_iterator();
+            i = map->at_index(i).nxt;
+            return *this;
+        }
+        /**
+         * iter--
+         */
+        iterator operator--(int)
+        {
+            iterator temp = *this;
+            --*this;
+            return temp;
+        }
+        /**
+         * --iter
+         */
+        iterator& operator--()
+        {
+            if (map == nullptr)
+                throw invalid_iterator();
+            index pre = i == nil ? map->tail : map->at_index(i).pre;
+            if (pre == nil)
+                throw invalid_iterator();
+            i = pre;
+            return *this;
+        }
+        /**
+         * if the iter didn't point to a value
+         * throw
+         * the value_pair is only read, so a shared chunk is not copied,
+         * write its value by modify(iter) or insert
+         */
+        const value_type& operator*() const
+        {
+            if (map == nullptr || i == nil)
+                throw invalid_iterator();
+            return *(map->at_index(i).val());
+        }
+        const value_type* operator->() const
+        {
+            if (map == nullptr || i == nil)
+                throw invalid_iterator();
+            return map->at_index(i).val();
+        }
+        /**
+         * other operation
+         */
+        bool operator==(const iterator& rhs) const
+        {
+            return map == rhs.map && i == rhs.i;
+        }
+        bool operator!=(const iterator& rhs) const
+        {
+            return !(*this == rhs);
+        }
+        bool operator==(const const_iterator& rhs) const
+        {
+            return map == rhs.map && i == rhs.i;
+        }
+        bool operator!=(const const_iterator& rhs) const
+        {
+            return !(*this == rhs);
+        }
+    };
+    class const_iterator {
+    public:
+        const compact_linked_hashmap* map;
+        index i;
+        const_iterator(const compact_linked_hashmap* map = nullptr, index i = nil)
+            : map(map)
+            , i(i)
+        {
+        }
+        const_iterator(const iterator& other)
+            : map(other.map)
+            , i(other.i)
+        {
+        }
+        const_iterator(const const_iterator& other) = default;
+        const_iterator& operator=(const const_iterator& other) = default;
+        /**
+         * iter++
+         */
+        const_iterator operator++(int)
+        {
+            const_iterator temp = *this;
+            ++*this;
+            return temp;
+        }
+        /**
+         * ++iter
+         */
+        const_iterator& operator++()
+        {
+            if (map == nullptr || i == nil)
+                throw invalid_iterator();
+            i = map->at_index(i).nxt;
+            return *this;
+        }
+        /**
+         * iter--
+         */
+        const_iterator operator--(int)
+        {
+            const_iterator temp = *this;
+            --*this;
+            return temp;
+        }
+        /**
+         * --iter
+         */
+        const_iterator& operator--()
+        {
+            if (map == nullptr)
+                throw invalid_iterator();
+            index pre = i == nil ? map->tail : map->at_index(i).pre;
+            if (pre == nil)
+                throw invalid_iterator();
+            i = pre;
+            return *this;
+        }
+        /**
+         * if the iter didn't point to a value
+         * throw
+         */
+        const value_type& operator*() const
+        {
+            if (map == nullptr || i == nil)
+                throw invalid_iterator();
+            return *(map->at_index(i).val());
+        }
+        const value_type* operator->() const
+        {
+            if (map == nullptr || i == nil)
+                throw invalid_iterator();
+            return map->at_index(i).val();
+        }
+        /**
+         * other operation
+         */
+        bool operator==(const iterator& rhs) const
+        {
+            return map == rhs.map && i == rhs.i;
+        }
+        bool operator!=(const iterator& rhs) const
+        {
+            return !(*this == rhs);
+        }
+        bool operator==(const const_iterator& rhs) const
+        {
+            return map == rhs.map && i == rhs.i;
+        }
+        bool operator!=(const const_iterator& rhs) const
+        {
+            return !(*this == rhs);
+        }
+    };
+
+    /**
+     * return the entry at index i for reading
+     */
+    const Entry& at_index(index i) const
+    {
+        return chunks[i >> chunk_bits]->entries[i & (chunk_size - 1)];
+    }
+
+    /**
+     * return the value connected with the key
+     * if the key not found, throw
+     * like the iterators, at only reads, see modify
+     */
+    const T& at(const Key& key) const
+    {
+        index i = locate(key, hash_mix(Hash()(key)));
+        if (i == nil)
+            throw index_out_of_bound();
+        return at_index(i).val()->second;
+    }
+    template <class K, class H = Hash, std::enable_if_t<is_transparent<H, Equal>::value, int> = 0>
+    const T& at(const K& key) const
+    {
+        index i = locate(key, hash_mix(Hash()(key)));
+        if (i == nil)
+            throw index_out_of_bound();
+        return at_index(i).val()->second;
+    }
+    const T& operator[](const Key& key) const
+    {
+        return at(key);
+    }
+    /**
+     * return the value at iterator pos for writing,
+     * its chunk is copied first if it is shared with a snapshot
+     * it stays where it is in the list
+     * if the iter didn't point to anything, throw
+     */
+    T& modify(iterator pos)
+    {
+        if (pos.map != this || pos.i == nil)
+            throw invalid_iterator();
+        return write_entry(pos.i).val()->second;
+    }
+
+    /**
+     * return an iterator point at the beginning
+     * const or not
+     */
+    iterator begin()
+    {
+        return iterator(this, head);
+    }
+    const_iterator cbegin() const
+    {
+        return const_iterator(this, head);
+    }
+    /**
+     * return an iterator point at the ending
+     * const or not
+     */
+    iterator end()
+    {
+        return iterator(this, nil);
+    }
+    const_iterator cend() const
+    {
+        return const_iterator(this, nil);
+    }
+
+    /**
+     * if didn't contain anything, return true,
+     * otherwise false.
+     */
+    bool empty() const
+    {
+        return elements == 0;
+    }
+    /**
+     * destroy the whole compact_linked_hashmap
+     * the value_pairs are destroyed with the last map sharing them
+     * can't be used after destroy
+     */
+    void destroy()
+    {
+        for (size_t i = 0; i < chunk_count; i++)
+            drop(chunks[i]);
+        delete[] chunks;
+        if (pages != nullptr) {
+            for (size_t i = 0; i <= (mask >> chunk_bits); i++)
+                drop(pages[i]);
+            delete[] pages;
+        }
+        chunks = nullptr;
+        pages = nullptr;
+        chunk_count = chunk_capacity = used = elements = 0;
+        head = tail = free_head = nil;
+        return;
+    }
+    /**
+     * clear the whole compact_linked_hashmap
+     * can be used after clear
+     */
+    void clear()
+    {
+        destroy();
+        init();
+        return;
+    }
+    /**
+     * return the number of value_pairs
+     */
+    size_t size() const
+    {
+        return elements;
+    }
+
+    /**
+     * find the iterator points at the value_pair
+     * which consist of key
+     * if not find, return an iterator
+     * point at nothing
+     */
+    iterator find(const Key& key)
+    {
+        return iterator(this, locate(key, hash_mix(Hash()(key))));
+    }
+    template <class K, class H = Hash, std::enable_if_t<is_transparent<H, Equal>::value, int> = 0>
+    iterator find(const K& key)
+    {
+        return iterator(this, locate(key, hash_mix(Hash()(key))));
+    }
+    /**
+     * return how many value_pairs consist of the key
+     * should only return 0 or 1
+     */
+    size_t count(const Key& key) const
+    {
+        return locate(key, hash_mix(Hash()(key))) != nil;
+    }
+    template <class K, class H = Hash, std::enable_if_t<is_transparent<H, Equal>::value, int> = 0>
+    size_t count(const K& key) const
+    {
+        return locate(key, hash_mix(Hash()(key))) != nil;
+    }
+    /**
+     * insert a new key
+     * already have a value_pair with the same key:
+     * just update the value, return false
+     * and move the value_pair to the end of the list
+     * not find a value_pair with the same key:
+     * insert the value_pair, return true
+     */
+    pair<iterator, bool> insert(const value_type& value)
+    {
+        index h = index(hash_mix(Hash()(value.first)));
+        index i = locate(value.first, h);
+        if (i != nil) {
+            write_entry(i).val()->second = value.second;
+            unlink(i);
+            link_tail(i);
+            return sjtu::pair<iterator, bool>(iterator(this, i), false);
+        }
+        if (elements > mask)
+            rehash((mask + 1) * 2);
+        i = acquire();
+        Entry& entry = write_entry(i);
+        new (entry.data) value_type(value);
+        entry.hash = h;
+        entry.chain = bucket(h & mask);
+        write_bucket(h & mask) = i;
+        link_tail(i);
+        elements++;
+        return sjtu::pair<iterator, bool>(iterator(this, i), true);
+    }
+    /**
+     * move the value_pair at iterator pos to the end of the list
+     * only the links are changed, nothing is copied
+     * if the iter didn't point to anything, throw
+     */
+    void move_to_back(iterator pos)
+    {
+        if (pos.map != this || pos.i == nil)
+            throw invalid_iterator();
+        if (pos.i != tail) {
+            unlink(pos.i);
+            link_tail(pos.i);
+        }
+        return;
+    }
+    /**
+     * move the value_pair of key to the end of the list
+     * return the iterator points at it, or end() if not find
+     */
+    iterator touch(const Key& key)
+    {
+        iterator it = find(key);
+        if (it != end())
+            move_to_back(it);
+        return it;
+    }
+    template <class K, class H = Hash, std::enable_if_t<is_transparent<H, Equal>::value, int> = 0>
+    iterator touch(const K& key)
+    {
+        iterator it = find(key);
+        if (it != end())
+            move_to_back(it);
+        return it;
+    }
+    /**
+     * erase the element at iterator pos
+     * if the iter didn't point to anything, throw
+     */
+    void remove(iterator pos)
+    {
+        if (pos.map != this || pos.i == nil)
+            throw invalid_iterator();
+        index i = pos.i;
+        size_t b = at_index(i).hash & mask;
+        index chain = at_index(i).chain;
+        if (bucket(b) == i) {
+            write_bucket(b) = chain;
+        } else {
+            index k = bucket(b);
+            while (at_index(k).chain != i)
+                k = at_index(k).chain;
+            write_entry(k).chain = chain;
+        }
+        unlink(i);
+        Entry& entry = write_entry(i);
+        entry.val()->~value_type();
+        entry.pre = vacant;
+        entry.nxt = free_head;
+        free_head = i;
+        elements--;
+        return;
+    }
+
+private:
+    /**
+     * allocate the empty map
+     */
+    void init()
+    {
+        chunks = nullptr;
+        chunk_count = chunk_capacity = used = elements = 0;
+        head = tail = free_head = nil;
+        mask = min_buckets - 1;
+        pages = new Page*[1];
+        pages[0] = new Page;
+    }
+    /**
+     * share the chunks and the pages of other
+     */
+    void share(const compact_linked_hashmap& other)
+    {
+        size_t page_count = (other.mask >> chunk_bits) + 1;
+        chunks = other.chunk_count == 0 ? nullptr : new Chunk*[other.chunk_count];
+        pages = new Page*[page_count];
+        for (size_t i = 0; i < other.chunk_count; i++) {
+            chunks[i] = other.chunks[i];
+            chunks[i]->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+        for (size_t i = 0; i < page_count; i++) {
+            pages[i] = other.pages[i];
+            pages[i]->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+        chunk_count = chunk_capacity = other.chunk_count;
+        used = other.used;
+        free_head = other.free_head;
+        mask = other.mask;
+        elements = other.elements;
+        head = other.head;
+        tail = other.tail;
+    }
+    /**
+     * stop sharing a chunk or a page,
+     * the last map sharing it destroys its value_pairs and frees it
+     */
+    static void drop(Chunk* chunk)
+    {
+        if (chunk->refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+        for (size_t k = 0; k < chunk_size; k++) {
+            if (chunk->entries[k].pre != vacant)
+                chunk->entries[k].val()->~value_type();
+        }
+        delete chunk;
+    }
+    static void drop(Page* page)
+    {
+        if (page->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete page;
+    }
+    /**
+     * return the entry at index i for writing
+     * a chunk shared with other maps is copied first, and is ours after that,
+     * so the references returned before stay valid
+     */
+    Entry& write_entry(index i)
+    {
+        Chunk*& chunk = chunks[i >> chunk_bits];
+        if (chunk->refs.load(std::memory_order_acquire) != 1)
+            chunk = unshare(chunk);
+        return chunk->entries[i & (chunk_size - 1)];
+    }
+    /**
+     * return the bucket b for reading or for writing, see write_entry
+     */
+    index bucket(size_t b) const
+    {
+        return pages[b >> chunk_bits]->slots[b & (chunk_size - 1)];
+    }
+    index& write_bucket(size_t b)
+    {
+        Page*& page = pages[b >> chunk_bits];
+        if (page->refs.load(std::memory_order_acquire) != 1)
+            page = unshare(page);
+        return page->slots[b & (chunk_size - 1)];
+    }
+    /**
+     * return a private copy of a shared chunk or page, and drop the shared one
+     */
+    static Chunk* unshare(Chunk* chunk)
+    {
+        Chunk* res = new Chunk;
+        try {
+            for (size_t k = 0; k < chunk_size; k++) {
+                const Entry& from = chunk->entries[k];
+                Entry& to = res->entries[k];
+                if (from.pre != vacant)
+                    new (to.data) value_type(*from.val());
+                to.hash = from.hash;
+                to.chain = from.chain;
+                to.nxt = from.nxt;
+                to.pre = from.pre;
+            }
+        } catch (...) {
+            drop(res);
+            throw;
+        }
+        drop(chunk);
+        return res;
+    }
+    static Page* unshare(Page* page)
+    {
+        Page* res = new Page;
+        memcpy(res->slots, page->slots, sizeof(res->slots));
+        drop(page);
+        return res;
+    }
+    /**
+     * return the index of the entry of key, whose mixed hash is h
+     * not find: return nil
+     */
+    template <class K, std::enable_if_t<is_lookup_key<K, Key, Hash, Equal>, int> = 0>
+    index locate(const K& key, size_t h) const
+    {
+        index i = bucket(h & mask);
+        while (i != nil) {
+            const Entry& entry = at_index(i);
+            if (entry.hash == index(h) && Equal()(entry.val()->first, key))
+                return i;
+            i = entry.chain;
+        }
+        return nil;
+    }
+    /**
+     * take an entry from the free-slot stack,
+     * or from the end of the arena
+     */
+    index acquire()
+    {
+        if (free_head != nil) {
+            index i = free_head;
+            free_head = at_index(i).nxt;
+            return i;
+        }
+        if (used >= vacant)
+            throw runtime_error();
+        if (used == chunk_count * chunk_size) {
+            if (chunk_count == chunk_capacity) {
+                chunk_capacity = chunk_capacity == 0 ? 1 : chunk_capacity * 2;
+                Chunk** new_chunks = new Chunk*[chunk_capacity];
+                for (size_t i = 0; i < chunk_count; i++)
+                    new_chunks[i] = chunks[i];
+                delete[] chunks;
+                chunks = new_chunks;
+            }
+            chunks[chunk_count] = new Chunk;
+            chunk_count++;
+        }
+        return index(used++);
+    }
+    /**
+     * rebuild the buckets with n buckets from the stored hashes
+     */
+    void rehash(size_t n)
+    {
+        size_t page_count = ((n - 1) >> chunk_bits) + 1;
+        Page** new_pages = new Page*[page_count];
+        for (size_t i = 0; i < page_count; i++)
+            new_pages[i] = new Page;
+        for (size_t i = 0; i <= (mask >> chunk_bits); i++)
+            drop(pages[i]);
+        delete[] pages;
+        pages = new_pages;
+        mask = n - 1;
+        for (index i = head; i != nil; i = at_index(i).nxt) {
+            Entry& entry = write_entry(i);
+            entry.chain = bucket(entry.hash & mask);
+            write_bucket(entry.hash & mask) = i;
+        }
+    }
+    /**
+     * put an entry at the end of the order
+     */
+    void link_tail(index i)
+    {
+        Entry& entry = write_entry(i);
+        entry.pre = tail;
+        entry.nxt = nil;
+        if (tail != nil)
+            write_entry(tail).nxt = i;
+        else
+            head = i;
+        tail = i;
+    }
+    /**
+     * take an entry out of the order
+     */
+    void unlink(index i)
+    {
+        index pre = at_index(i).pre, nxt = at_index(i).nxt;
+        if (pre != nil)
+            write_entry(pre).nxt = nxt;
+        else
+            head = nxt;
+        if (nxt != nil)
+            write_entry(nxt).pre = pre;
+        else
+            tail = pre;
+    }
+};
+
+/**
+ * the value of an entry of basic_lru,
+ * carrying the bookkeeping of the eviction policy and of the expiry
+ * next to the matrix (an empty meta takes no space)
+ */
+template <class... Meta>
+struct cache_entry : Meta... {
+    Matrix<int> value;
+    template <class... Args>
+    cache_entry(Args&&... args)
+        : value(std::forward<Args>(args)...)
+    {
+    }
+};
+
+/**
+ * the eviction policies of basic_lru
+ * a policy has a type meta (stored in every entry) and four hooks,
+ * each given the index of the cache and the entry concerned:
+ * on_hit: a get found the entry, or a save replaced its value
+ * on_insert: a save added the entry
+ * choose_victim: the cache is over its size, return the entry to evict
+ * on_remove: the entry is about to be evicted
+ */
+
+/**
+ * least recently used: a hit moves the entry to the end of the list,
+ * and the victim is the front
+ */
+class lru_policy {
+public:
+    struct meta {
+    };
+    template <class Map>
+    void on_hit(Map& map, typename Map::iterator it)
+    {
+        map.move_to_back(it);
+    }
+    template <class Map>
+    void on_insert(Map&, typename Map::iterator)
+    {
+    }
+    template <class Map>
+    typename Map::iterator choose_victim(Map& map)
+    {
+        return map.begin();
+    }
+    template <class Map>
+    void on_remove(Map&, typename Map::iterator)
+    {
+    }
+};
+/**
+ * first in first out: a hit changes nothing,
+ * and the victim is the entry saved first
+ */
+class fifo_policy {
+public:
+    struct meta {
+    };
+    template <class Map>
+    void on_hit(Map&, typename Map::iterator)
+    {
+    }
+    template <class Map>
+    void on_insert(Map&, typename Map::iterator)
+    {
+    }
+    template <class Map>
+    typename Map::iterator choose_victim(Map& map)
+    {
+        return map.begin();
+    }
+    template <class Map>
+    void on_remove(Map&, typename Map::iterator)
+    {
+    }
+};
+/**
+ * CLOCK (second chance): a hit only sets the referenced bit of the entry,
+ * so it writes one byte next to the key and relinks nothing
+ * the list is the clock face and its front is the hand:
+ * choose_victim clears the bit of referenced entries and moves them
+ * behind the hand (to the end), until it meets an unreferenced one
+ * there is no hand to keep apart from the list,
+ * so the policy stays valid when the cache is copied or moved
+ */
+class clock_policy {
+public:
+    struct meta {
+        bool referenced = false;
+    };
+    template <class Map>
+    void on_hit(Map&, typename Map::iterator it)
+    {
+        it->second.referenced = true;
+    }
+    template <class Map>
+    void on_insert(Map&, typename Map::iterator)
+    {
+    }
+    /**
+     * the last entry (the one just saved) is passed over,
+     * unless it is the only one,
+     * so a cache of all referenced entries does not evict it
+     * after one round every other bit is clear
+     */
+    template <class Map>
+    typename Map::iterator choose_victim(Map& map)
+    {
+        typename Map::iterator last = --map.end();
+        typename Map::iterator it = map.begin();
+        while (it->second.referenced || (it == last && map.size() > 1)) {
+            if (it != last)
+                it->second.referenced = false;
+            map.move_to_back(it);
+            it = map.begin();
+        }
+        return it;
+    }
+    template <class Map>
+    void on_remove(Map&, typename Map::iterator)
+    {
+    }
+};
+/**
+ * random: a hit changes nothing, and the victim is a uniformly random entry
+ * other than the one just saved (the last of the list)
+ * the policy keeps the keys in a dense array, every entry knows its position,
+ * and a removal moves the last key into the hole,
+ * so picking and removing are O(1) (plus one lookup)
+ * keys are stored rather than iterators, so a copy of the cache
+ * or an entry moved into a new node keeps its position
+ * Key is the key type of the map
+ */
+template <class Key = Integer>
+class random_policy {
+public:
+    struct meta {
+        size_t position;
+    };
+    /**
+     * the state of the xorshift generator, never 0
+     * keys: count keys of the entries, room for capacity
+     */
+    unsigned long long state;
+    Key* keys;
+    size_t count, capacity;
+    random_policy(unsigned long long seed = 0x9e3779b97f4a7c15ULL)
+        : state(seed | 1)
+        , keys(nullptr)
+        , count(0)
+        , capacity(0)
+    {
+    }
+    random_policy(const random_policy& other)
+        : state(other.state)
+        , keys(other.capacity > 0 ? allocate(other.capacity) : nullptr)
+        , count(0)
+        , capacity(other.capacity)
+    {
+        try {
+            for (; count < other.count; count++)
+                new (keys + count) Key(other.keys[count]);
+        } catch (...) {
+            release();
+            throw;
+        }
+    }
+    random_policy(random_policy&& other) noexcept
+        : state(other.state)
+        , keys(other.keys)
+        , count(other.count)
+        , capacity(other.capacity)
+    {
+        other.keys = nullptr;
+        other.count = other.capacity = 0;
+    }
+    ~random_policy()
+    {
+        release();
+    }
+    random_policy& operator=(random_policy other) noexcept
+    {
+        std::swap(state, other.state);
+        std::swap(keys, other.keys);
+        std::swap(count, other.count);
+        std::swap(capacity, other.capacity);
+        return *this;
+    }
+
+    template <class Map>
+    void on_hit(Map&, typename Map::iterator)
+    {
+    }
+    template <class Map>
+    void on_insert(Map&, typename Map::iterator it)
+    {
+        if (count == capacity)
+            grow(capacity > 0 ? capacity * 2 : 16);
+        new (keys + count) Key(it->first);
+        static_cast<meta&>(it->second).position = count++;
+    }
+    template <class Map>
+    typename Map::iterator choose_victim(Map& map)
+    {
+        if (count <= 1)
+            return map.begin();
+        typename Map::iterator last = --map.end();
+        typename Map::iterator res = map.find(keys[next() % count]);
+        if (res == last)
+            res = map.find(keys[(static_cast<meta&>(res->second).position + 1 + next() % (count - 1)) % count]);
+        return res;
+    }
+    template <class Map>
+    void on_remove(Map& map, typename Map::iterator it)
+    {
+        size_t i = static_cast<meta&>(it->second).position;
+        if (i != --count) {
+            keys[i] = std::move(keys[count]);
+            static_cast<meta&>(map.find(keys[i])->second).position = i;
+        }
+        keys[count].~Key();
+    }
+
+private:
+    unsigned long long next()
+    {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545f4914f6cdd1dULL;
+    }
+    static Key* allocate(size_t n)
+    {
+        return static_cast<Key*>(::operator new(n * sizeof(Key)));
+    }
+    /**
+     * move the keys into room for n
+     */
+    void grow(size_t n)
+    {
+        Key* res = allocate(n);
+        for (size_t i = 0; i < count; i++) {
+            new (res + i) Key(std::move(keys[i]));
+            keys[i].~Key();
+        }
+        ::operator delete(keys);
+        keys = res;
+        capacity = n;
+    }
+    void release()
+    {
+        for (size_t i = 0; i < count; i++)
+            keys[i].~Key();
+        ::operator delete(keys);
+        keys = nullptr;
+        count = capacity = 0;
+    }
+};
+
+/**
+ * the weighers of basic_lru, giving the weight of an entry by its key and value
+ * the cache keeps the total weight of its entries at most its size
+ */
+
+/**
+ * every entry weighs 1, so size counts the entries
+ */
+class count_weigher {
+public:
+    template <class T>
+    size_t operator()(const Integer&, const Matrix<T>&) const
+    {
+        return 1;
+    }
+};
+
+/**
+ * an entry weighs the bytes of its elements, of its rows and of its node,
+ * so size is a budget of bytes
+ * every row of a Matrix is a std::vector of its own
+ * links: the list links, chain pointer and hash in every node
+ */
+class byte_weigher {
+public:
+    static constexpr size_t links = 3 * sizeof(void*) + sizeof(size_t);
+    template <class T>
+    size_t operator()(const Integer&, const Matrix<T>& value) const
+    {
+        return value.RowSize() * (value.ColSize() * sizeof(T) + sizeof(std::vector<T>)) + sizeof(Integer) + sizeof(Matrix<T>) + links;
+    }
+};
+
+/**
+ * hashed hierarchical timer wheel, in ticks
+ * level l has slots for the next 64 ^ (l + 1) ticks, 64 ^ l ticks each,
+ * a timer sits in the slot of the lowest level that reaches its deadline
+ * (or in the last slot of the top level, when that is too near)
+ * advancing a tick fires the slot of the tick in level 0,
+ * after taking the slots the tick starts in the upper levels
+ * down to the level their timers now fit, so a timer moves down
+ * at most levels - 1 times, and scheduling and cancelling are O(1)
+ * a bitmap per level marks the occupied slots, so advancing jumps
+ * from one occupied slot to the next instead of walking every tick
+ * the timers are intrusive: a copy of a timer is never scheduled,
+ * a moved timer is scheduled in place of the one it is moved from
+ */
+class timer_wheel {
+public:
+    static constexpr size_t levels = 4, bits = 6, slots = 1 << bits;
+    class timer {
+    public:
+        timer* nxt = nullptr;
+        timer** pprev = nullptr;
+        unsigned long long deadline = 0;
+        /**
+         * the slot it is in, level * slots + index
+         */
+        size_t slot = 0;
+        timer() = default;
+        timer(const timer& other)
+            : deadline(other.deadline)
+        {
+        }
+        /**
+         * a moved timer takes the place of other in the wheel,
+         * so an entry relocated into a new node (see shrink_to_fit)
+         * keeps its deadline, and the old node can be freed
+         */
+        timer(timer&& other) noexcept
+            : nxt(other.nxt)
+            , pprev(other.pprev)
+            , deadline(other.deadline)
+            , slot(other.slot)
+        {
+            if (pprev != nullptr) {
+                *pprev = this;
+                if (nxt != nullptr)
+                    nxt->pprev = &nxt;
+                other.nxt = nullptr;
+                other.pprev = nullptr;
+            }
+        }
+        /**
+         * an assigned timer keeps its own schedule
+         */
+        timer& operator=(const timer&)
+        {
+            return *this;
+        }
+    };
+    /**
+     * the first timer of every slot
+     * occupied: bit i of level l is set iff wheel[l][i] is not empty
+     * now: the last tick advanced to, every deadline up to it has fired
+     * count: the number of timers scheduled
+     */
+    timer* wheel[levels][slots];
+    unsigned long long occupied[levels];
+    unsigned long long now;
+    size_t count;
+
+    explicit timer_wheel(unsigned long long now = 0)
+        : now(now)
+        , count(0)
+    {
+        memset(wheel, 0, sizeof(wheel));
+        memset(occupied, 0, sizeof(occupied));
+    }
+    /**
+     * a copy starts at the same tick without the timers,
+     * their owner schedules their copies again
+     */
+    timer_wheel(const timer_wheel& other)
+        : timer_wheel(other.now)
+    {
+    }
+    timer_wheel(timer_wheel&& other) noexcept
+        : timer_wheel(other.now)
+    {
+        swap(other);
+    }
+    timer_wheel& operator=(timer_wheel other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+    void swap(timer_wheel& other) noexcept
+    {
+        for (size_t l = 0; l < levels; l++) {
+            for (size_t i = 0; i < slots; i++)
+                std::swap(wheel[l][i], other.wheel[l][i]);
+            std::swap(occupied[l], other.occupied[l]);
+        }
+        std::swap(now, other.now);
+        std::swap(count, other.count);
+        adopt();
+        other.adopt();
+    }
+
+    /**
+     * fire t at the deadline, or at the next tick if it is not after now
+     * t must not be scheduled
+     */
+    void schedule(timer* t, unsigned long long deadline)
+    {
+        t->deadline = deadline > now ? deadline : now + 1;
+        link(t);
+        count++;
+    }
+    /**
+     * unschedule t, if it is scheduled
+     */
+    void cancel(timer* t)
+    {
+        if (t->pprev == nullptr)
+            return;
+        unlink(t);
+        count--;
+    }
+    /**
+     * advance to the tick to, calling expire(t) for every timer t due,
+     * after unscheduling it
+     * only the ticks where an occupied slot fires or cascades are visited,
+     * so the work is by the timers moved, not by the ticks passed
+     */
+    template <class F>
+    void advance(unsigned long long to, F&& expire)
+    {
+        while (now < to) {
+            unsigned long long tick = next_tick();
+            if (tick > to) {
+                now = to;
+                return;
+            }
+            now = tick;
+            for (size_t l = levels - 1; l > 0; l--) {
+                if ((now & ((1ULL << (bits * l)) - 1)) == 0) {
+                    timer* t = take(l, (now >> (bits * l)) & (slots - 1));
+                    while (t != nullptr) {
+                        timer* nxt = t->nxt;
+                        link(t);
+                        t = nxt;
+                    }
+                }
+            }
+            timer* t = take(0, now & (slots - 1));
+            while (t != nullptr) {
+                timer* nxt = t->nxt;
+                t->pprev = nullptr;
+                count--;
+                expire(t);
+                t = nxt;
+            }
+        }
+    }
+
+private:
+    /**
+     * put t into its slot, by its deadline (not before now) from now
+     */
+    void link(timer* t)
+    {
+        unsigned long long at = t->deadline > now ? t->deadline : now;
+        size_t l = 0;
+        while (l + 1 < levels && at - now >= (1ULL << (bits * (l + 1))))
+            l++;
+        if (at - now >= (1ULL << (bits * levels)))
+            at = now + (1ULL << (bits * levels)) - 1;
+        size_t i = (at >> (bits * l)) & (slots - 1);
+        timer*& head = wheel[l][i];
+        t->nxt = head;
+        t->pprev = &head;
+        t->slot = l * slots + i;
+        if (head != nullptr)
+            head->pprev = &t->nxt;
+        head = t;
+        occupied[l] |= 1ULL << i;
+    }
+    void unlink(timer* t)
+    {
+        *t->pprev = t->nxt;
+        if (t->nxt != nullptr)
+            t->nxt->pprev = t->pprev;
+        t->pprev = nullptr;
+        if (wheel[t->slot / slots][t->slot % slots] == nullptr)
+            occupied[t->slot / slots] &= ~(1ULL << (t->slot % slots));
+    }
+    /**
+     * empty the slot and return its timers,
+     * which stay counted until they fire
+     */
+    timer* take(size_t l, size_t i)
+    {
+        timer* res = wheel[l][i];
+        wheel[l][i] = nullptr;
+        occupied[l] &= ~(1ULL << i);
+        return res;
+    }
+    /**
+     * the first tick after now where an occupied slot fires (level 0)
+     * or cascades (the start of its span, upper levels),
+     * or ULLONG_MAX with no timer scheduled
+     */
+    unsigned long long next_tick() const
+    {
+        unsigned long long res = ~0ULL;
+        for (size_t l = 0; l < levels; l++) {
+            if (occupied[l] == 0)
+                continue;
+            unsigned long long span = now >> (bits * l);
+            unsigned long long tick = (span + distance(occupied[l], span & (slots - 1))) << (bits * l);
+            if (tick < res)
+                res = tick;
+        }
+        return res;
+    }
+    /**
+     * the least d in [1, slots] with slot (from + d) % slots set in mask
+     * mask must not be 0
+     */
+    static size_t distance(unsigned long long mask, size_t from)
+    {
+        size_t shift = (from + 1) & (slots - 1);
+        if (shift != 0)
+            mask = (mask >> shift) | (mask << (slots - shift));
+#ifdef __GNUC__
+        return __builtin_ctzll(mask) + 1;
+#else
+        size_t d = 1;
+        for (; (mask & 1) == 0; mask >>= 1)
+            d++;
+        return d;
+#endif
+    }
+    /**
+     * point the first timer of every slot back at its slot
+     */
+    void adopt()
+    {
+        for (size_t l = 0; l < levels; l++)
+            for (size_t i = 0; i < slots; i++)
+                if (wheel[l][i] != nullptr)
+                    wheel[l][i]->pprev = &wheel[l][i];
+    }
+};
+
+/**
+ * the expiries of basic_lru
+ * an expiry has a type meta (stored in every entry) and the hooks:
+ * advance(expire): call expire(meta*) for every entry expired by now
+ * on_write: a save added the entry or replaced its value, with a ttl or not
+ * on_read: a get found the entry
+ * on_remove: the entry is about to be evicted
+ * restore: the entry was copied with the cache, schedule it again
+ */
+
+/**
+ * nothing expires
+ */
+class no_expiry {
+public:
+    struct meta {
+    };
+    static constexpr bool enabled = false;
+    template <class F>
+    void advance(F&&)
+    {
+    }
+    void on_write(meta&, int)
+    {
+    }
+    void on_read(meta&)
+    {
+    }
+    void on_remove(meta&)
+    {
+    }
+    void restore(meta&)
+    {
+    }
+};
+
+/**
+ * milliseconds of std::chrono::steady_clock, the default clock of expiries
+ */
+class steady_ticks {
+public:
+    unsigned long long operator()() const
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+};
+
+/**
+ * an entry expires ttl ticks (of Clock) after it was last written,
+ * or also read if Access
+ * a save may give the entry a ttl of its own instead of the default one
+ * the entries are kept in a timer_wheel by deadline,
+ * so expiring takes amortized O(1) each and a get never checks a deadline
+ */
+template <bool Access, class Clock = steady_ticks>
+class basic_expiry {
+public:
+    /**
+     * key: the key of the entry, to find it when it expires
+     */
+    struct meta : timer_wheel::timer {
+        int key;
+        unsigned long long ttl;
+    };
+    static constexpr bool enabled = true;
+    unsigned long long ttl;
+    Clock clock;
+    timer_wheel wheel;
+    explicit basic_expiry(unsigned long long ttl, Clock clock = Clock())
+        : ttl(ttl)
+        , clock(clock)
+        , wheel(this->clock())
+    {
+    }
+
+    template <class F>
+    void advance(F&& expire)
+    {
+        wheel.advance(clock(), [&](timer_wheel::timer* t) { expire(static_cast<meta*>(t)); });
+    }
+    void on_write(meta& m, int key)
+    {
+        on_write(m, key, ttl);
+    }
+    void on_write(meta& m, int key, unsigned long long ttl)
+    {
+        m.key = key;
+        m.ttl = ttl;
+        wheel.cancel(&m);
+        wheel.schedule(&m, wheel.now + ttl);
+    }
+    void on_read(meta& m)
+    {
+        if constexpr (Access) {
+            if (m.deadline != wheel.now + m.ttl) {
+                wheel.cancel(&m);
+                wheel.schedule(&m, wheel.now + m.ttl);
+            }
+        }
+    }
+    void on_remove(meta& m)
+    {
+        wheel.cancel(&m);
+    }
+    void restore(meta& m)
+    {
+        wheel.schedule(&m, m.deadline);
+    }
+};
+
+template <class Clock = steady_ticks>
+using expire_after_write = basic_expiry<false, Clock>;
+template <class Clock = steady_ticks>
+using expire_after_access = basic_expiry<true, Clock>;
+
+/**
+ * why an entry left basic_lru
+ * size: evicted to fit the size
+ * erased: removed by erase
+ * expired: dropped by the expiry
+ * replaced: a save gave the key a new value (the old one is passed)
+ */
+enum class removal_cause {
+    size,
+    erased,
+    expired,
+    replaced,
+};
+
+/**
+ * the listeners of basic_lru
+ * a listener has a type meta (stored in every entry) and the hooks:
+ * on_write: a save added the entry or replaced its value
+ * on_remove: the entry (or its old value, if replaced) is about to go,
+ * its value may be moved from
+ * sync: hand over everything held back, see write_back
+ */
+
+/**
+ * nothing listens
+ */
+class no_listener {
+public:
+    struct meta {
+    };
+    void on_write(meta&)
+    {
+    }
+    void on_remove(meta&, const Integer&, Matrix<int>&, removal_cause)
+    {
+    }
+    template <class Map>
+    void sync(Map&)
+    {
+    }
+};
+
+/**
+ * call f(key, value, cause) for every entry removed
+ */
+template <class F>
+class removal_listener {
+public:
+    struct meta {
+    };
+    F f;
+    removal_listener(F f = F())
+        : f(f)
+    {
+    }
+    void on_write(meta&)
+    {
+    }
+    void on_remove(meta&, const Integer& key, Matrix<int>& value, removal_cause cause)
+    {
+        f(key, value, cause);
+    }
+    template <class Map>
+    void sync(Map&)
+    {
+    }
+};
+
+/**
+ * write-back: a save marks the entry dirty, and a dirty entry leaving
+ * the cache (for any cause but replaced, whose newer value stays dirty)
+ * is queued and handed to flush(value_type* pairs, size_t n)
+ * by batch, so repeated saves of a key reach the store as one write
+ * the queue is allocated once, the pairs may be moved from by flush
+ * sync flushes the queue, then the dirty entries in the cache (by copy)
+ * a write_back is not copyable: a copy would write everything twice
+ */
+template <class Flush>
+class write_back {
+public:
+    using value_type = sjtu::pair<const Integer, Matrix<int>>;
+    static constexpr size_t batch = 64;
+    struct meta {
+        bool dirty = false;
+    };
+    Flush flush;
+    /**
+     * the queue, count pairs of the batch are constructed
+     * a moved-from write_back has none until it queues again
+     */
+    value_type* pending;
+    size_t count;
+    write_back(Flush flush = Flush())
+        : flush(flush)
+        , pending(static_cast<value_type*>(::operator new(batch * sizeof(value_type))))
+        , count(0)
+    {
+    }
+    write_back(const write_back& other) = delete;
+    write_back(write_back&& other) noexcept
+        : flush(std::move(other.flush))
+        , pending(other.pending)
+        , count(other.count)
+    {
+        other.pending = nullptr;
+        other.count = 0;
+    }
+    /**
+     * the queue is flushed before it is freed
+     */
+    ~write_back()
+    {
+        drain();
+        ::operator delete(pending);
+    }
+    write_back& operator=(const write_back& other) = delete;
+    write_back& operator=(write_back&& other) noexcept
+    {
+        std::swap(flush, other.flush);
+        std::swap(pending, other.pending);
+        std::swap(count, other.count);
+        return *this;
+    }
+
+    void on_write(meta& m)
+    {
+        m.dirty = true;
+    }
+    void on_remove(meta& m, const Integer& key, Matrix<int>& value, removal_cause cause)
+    {
+        if (!m.dirty || cause == removal_cause::replaced)
+            return;
+        queue(key, std::move(value));
+    }
+    template <class Map>
+    void sync(Map& map)
+    {
+        for (typename Map::iterator it = map.begin(); it != map.end(); it++) {
+            meta& m = it->second;
+            if (m.dirty) {
+                m.dirty = false;
+                queue(it->first, it->second.value);
+            }
+        }
+        drain();
+    }
+
+private:
+    template <class V>
+    void queue(const Integer& key, V&& value)
+    {
+        if (pending == nullptr)
+            pending = static_cast<value_type*>(::operator new(batch * sizeof(value_type)));
+        new (pending + count) value_type(key, std::forward<V>(value));
+        if (++count == batch)
+            drain();
+    }
+    /**
+     * flush the queue, if not empty
+     */
+    void drain()
+    {
+        if (count == 0)
+            return;
+        flush(pending, count);
+        for (size_t i = 0; i < count; i++)
+            pending[i].~value_type();
+        count = 0;
+    }
+};
+
+/**
+ * the cache of matrices, evicting by Policy
+ * while the total weight (by Weigher) of its entries is more than size,
+ * dropping the entries expired by Expiry,
+ * and telling Listener about every entry written or removed
+ */
+template <class Policy, class Weigher = count_weigher, class Expiry = no_expiry, class Listener = no_listener>
+class basic_lru {
+    using entry = cache_entry<typename Policy::meta, typename Expiry::meta, typename Listener::meta>;
+    using lmap = sjtu::linked_hashmap<Integer, entry, Hash, Equal>;
+    using value_type = sjtu::pair<const Integer, Matrix<int>>;
+
+public:
+    /**
+     * the total weight allowed, and the total weight in the memory
+     * pop while the memory is over size
+     */
+    size_t size, weight;
+    lmap map;
+    Policy policy;
+    Weigher weigher;
+    Expiry expiry;
+    Listener listener;
+    /**
+     * counting entries, the index is sized for size + 1 value_pairs up front
+     * (save inserts before it evicts),
+     * so filling the memory never expands it
+     */
+    basic_lru(long long size, Policy policy = Policy(), Weigher weigher = Weigher(), Expiry expiry = Expiry(), Listener listener = Listener())
+        : size(size > 0 ? size : 0)
+        , weight(0)
+        , policy(policy)
+        , weigher(weigher)
+        , expiry(std::move(expiry))
+        , listener(std::move(listener))
+    {
+        if constexpr (std::is_same_v<Weigher, count_weigher>) {
+            if (size > 0)
+                map.reserve(this->size + 1);
+        }
+    }
+    basic_lru(long long size, Expiry expiry)
+        : basic_lru(size, Policy(), Weigher(), std::move(expiry))
+    {
+    }
+    basic_lru(long long size, Listener listener)
+        : basic_lru(size, Policy(), Weigher(), Expiry(), std::move(listener))
+    {
+    }
+    /**
+     * the copied entries are scheduled in the copied expiry again
+     */
+    basic_lru(const basic_lru& other)
+        : size(other.size)
+        , weight(other.weight)
+        , map(other.map)
+        , policy(other.policy)
+        , weigher(other.weigher)
+        , expiry(other.expiry)
+        , listener(other.listener)
+    {
+        if constexpr (Expiry::enabled) {
+            for (typename lmap::iterator it = map.begin(); it != map.end(); it++)
+                expiry.restore(it->second);
+        }
+    }
+    /**
+     * hand the memory over in O(1), see linked_hashmap
+     * other is left empty, and can be filled again
+     */
+    basic_lru(basic_lru&& other) noexcept
+        : size(other.size)
+        , weight(other.weight)
+        , map(std::move(other.map))
+        , policy(std::move(other.policy))
+        , weigher(std::move(other.weigher))
+        , expiry(std::move(other.expiry))
+        , listener(std::move(other.listener))
+    {
+        other.weight = 0;
+    }
+    /**
+     * the listener gets everything held back, see sync
+     */
+    ~basic_lru()
+    {
+        listener.sync(map);
+    }
+    /**
+     * the old entries go away with a temporary, so they are synced too
+     */
+    basic_lru& operator=(const basic_lru& other)
+    {
+        if (this != &other) {
+            basic_lru tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+    basic_lru& operator=(basic_lru&& other) noexcept
+    {
+        if (this != &other) {
+            basic_lru tmp(std::move(other));
+            swap(tmp);
+        }
+        return *this;
+    }
+    void swap(basic_lru& other) noexcept
+    {
+        std::swap(size, other.size);
+        std::swap(weight, other.weight);
+        map.swap(other.map);
+        std::swap(policy, other.policy);
+        std::swap(weigher, other.weigher);
+        std::swap(expiry, other.expiry);
+        std::swap(listener, other.listener);
+    }
+
+    /**
+     * save the value_pair in the memory
+     * delete something in the memory if necessary
+     */
+    void save(const value_type& v)
+    {
+        expire();
+        put(v, map.hash(v.first));
+        return;
+    }
+    /**
+     * save a temporary value_pair by moving it into the memory,
+     * so a big matrix is never copied
+     */
+    void save(value_type&& v)
+    {
+        expire();
+        put(std::move(v), map.hash(v.first));
+        return;
+    }
+    /**
+     * save the value_pair to expire ttl ticks after, instead of the default
+     */
+    void save(const value_type& v, unsigned long long ttl)
+    {
+        static_assert(Expiry::enabled, "save with a ttl needs an expiry");
+        expire();
+        put(v, map.hash(v.first), ttl);
+        return;
+    }
+    void save(value_type&& v, unsigned long long ttl)
+    {
+        static_assert(Expiry::enabled, "save with a ttl needs an expiry");
+        expire();
+        put(std::move(v), map.hash(v.first), ttl);
+        return;
+    }
+    /**
+     * return a pointer contain the value
+     * a hit is one lookup and the on_hit of the policy,
+     * the value is neither copied nor reallocated,
+     * so the pointer stays valid until the key is evicted
+     */
+    Matrix<int>* get(const Integer& v)
+    {
+        expire();
+        return hit(map.find(v));
+    }
+    /**
+     * get by a plain int, no Integer is constructed for the lookup
+     */
+    Matrix<int>* get(int v)
+    {
+        expire();
+        return hit(map.find(v));
+    }
+    /**
+     * get with the hash of the key computed ahead by map.hash(v)
+     */
+    Matrix<int>* get(int v, size_t h)
+    {
+        expire();
+        return hit(map.find(v, h));
+    }
+    /**
+     * get n keys at once, out[i] = get(keys[i])
+     * the lookups of a batch overlap their cache misses (see find_many),
+     * then the hits are passed to the policy in the order of keys,
+     * which leaves the same order as n single gets
+     */
+    template <class K>
+    void get_many(const K* keys, size_t n, Matrix<int>** out)
+    {
+        expire();
+        typename lmap::iterator res[lmap::batch];
+        for (size_t i = 0; i < n; i += lmap::batch) {
+            size_t m = n - i < lmap::batch ? n - i : lmap::batch;
+            map.find_many(keys + i, m, res);
+            for (size_t j = 0; j < m; j++)
+                out[i + j] = hit(res[j]);
+        }
+        return;
+    }
+    /**
+     * save every value_pair of the forward range [first, last) in order
+     * the keys of a batch are hashed and prefetched before the inserts
+     * a range of std::move_iterator moves the value_pairs in
+     */
+    template <class ForwardIt>
+    void save_many(ForwardIt first, ForwardIt last)
+    {
+        expire();
+        size_t h[lmap::batch];
+        while (first != last) {
+            size_t m = 0;
+            for (ForwardIt it = first; m < lmap::batch && it != last; ++it, ++m) {
+                h[m] = map.hash((*it).first);
+                map.prefetch_bucket(h[m]);
+            }
+            for (size_t j = 0; j < m; j++)
+                map.prefetch_chain(h[j]);
+            for (size_t j = 0; j < m; j++, ++first)
+                put(*first, h[j]);
         }
-        /**
-         * other operation
-         */
-        bool operator==(const iterator& rhs) const
-        {
-            return p == rhs.p;
+        return;
+    }
+
+    /**
+     * remove the key, return whether it was in the memory
+     */
+    bool erase(const Integer& v)
+    {
+        return erase(v.val);
+    }
+    bool erase(int v)
+    {
+        expire();
+        typename lmap::iterator it = map.find(v);
+        if (it == map.end())
+            return false;
+        policy.on_remove(map, it);
+        remove(it, removal_cause::erased);
+        return true;
+    }
+    /**
+     * hand everything held back by the listener over,
+     * for write_back: flush every dirty entry, which stays in the memory
+     */
+    void sync()
+    {
+        listener.sync(map);
+        return;
+    }
+
+    /**
+     * print everything in the memory
+     */
+    void print()
+    {
+        expire();
+        for (typename lmap::iterator it = map.begin(); it != map.end(); it++)
+            std::cout << (it->first).val << " " << it->second.value << std::endl;
+        return;
+    }
+
+private:
+    /**
+     * save v, whose key has the mixed hash h
+     * a present key gets the new value and counts as a hit,
+     * a new one is inserted
+     * then victims are pushed out until the weight fits,
+     * which may take several for a heavy value
+     * a value heavier than size is evicted alone right away,
+     * instead of pushing out everything else before it
+     * v is only moved from once it is known which of them happens
+     */
+    template <class V, class... Ttl>
+    void put(V&& v, size_t h, Ttl... ttl)
+    {
+        pair<typename lmap::iterator, bool> res = map.emplace_hashed(v.first, h, std::in_place, v.first, std::forward<V>(v).second);
+        if (!res.second) {
+            weight -= weigher(res.first->first, res.first->second.value);
+            listener.on_remove(res.first->second, res.first->first, res.first->second.value, removal_cause::replaced);
+            res.first->second.value = std::forward<V>(v).second;
+            weight += weigher(res.first->first, res.first->second.value);
+            expiry.on_write(res.first->second, res.first->first.val, ttl...);
+            listener.on_write(res.first->second);
+            policy.on_hit(map, res.first);
+        } else {
+            weight += weigher(res.first->first, res.first->second.value);
+            expiry.on_write(res.first->second, res.first->first.val, ttl...);
+            listener.on_write(res.first->second);
+            policy.on_insert(map, res.first);
         }
-        bool operator!=(const iterator& rhs) const
-        {
-            return p != rhs.p;
+        if (weigher(res.first->first, res.first->second.value) > size) {
+            policy.on_remove(map, res.first);
+            remove(res.first, removal_cause::size);
+            return;
         }
-        bool operator==(const const_iterator& rhs) const
-        {
-            return p == rhs.p;
+        while (weight > size) {
+            typename lmap::iterator victim = policy.choose_victim(map);
+            policy.on_remove(map, victim);
+            remove(victim, removal_cause::size);
         }
-        bool operator!=(const const_iterator& rhs) const
-        {
-            return p != rhs.p;
+    }
+    /**
+     * drop the entries expired by now
+     */
+    void expire()
+    {
+        expiry.advance([this](auto* m) {
+            typename lmap::iterator it = map.find(m->key);
+            policy.on_remove(map, it);
+            remove(it, removal_cause::expired);
+        });
+    }
+    /**
+     * remove the entry, after its policy bookkeeping
+     * the weight is taken before the listener may move the value
+     */
+    void remove(typename lmap::iterator it, removal_cause cause)
+    {
+        expiry.on_remove(it->second);
+        weight -= weigher(it->first, it->second.value);
+        listener.on_remove(it->second, it->first, it->second.value, cause);
+        map.remove(it);
+    }
+    /**
+     * pass a found entry to the policy and return its matrix
+     */
+    Matrix<int>* hit(typename lmap::iterator it)
+    {
+        if (it == map.end())
+            return nullptr;
+        expiry.on_read(it->second);
+        policy.on_hit(map, it);
+        return &(it->second.value);
+    }
+};
+
+using lru = basic_lru<lru_policy>;
+using fifo_cache = basic_lru<fifo_policy>;
+using random_cache = basic_lru<random_policy<>>;
+using clock_cache = basic_lru<clock_policy>;
+using byte_lru = basic_lru<lru_policy, byte_weigher>;
+template <class Expiry = expire_after_write<>>
+using expiring_lru = basic_lru<lru_policy, count_weigher, Expiry>;
+template <class Flush>
+using write_back_lru = basic_lru<lru_policy, count_weigher, no_expiry, write_back<Flush>>;
+
+/**
+ * ARC (adaptive replacement cache) of matrices, with the interface of lru
+ * t1: the resident keys used once lately, t2: the ones used at least twice
+ * b1, b2: the ghosts (keys without matrix) lately evicted from t1 and t2
+ * p is the target size of t1, grown by a save hitting b1 and shrunk by one
+ * hitting b2, so a scan of new keys only churns t1
+ * and leaves the hot keys of t2 in the memory
+ * every list is a linked_hashmap from its front (least recent) to its end,
+ * and they all share Hash, so a key is hashed once per operation
+ */
+class arc {
+    using value_type = sjtu::pair<const Integer, Matrix<int>>;
+    using resident = sjtu::linked_hashmap<Integer, Matrix<int>, Hash, Equal>;
+    using ghost = sjtu::linked_hashmap<Integer, char, Hash, Equal>;
+
+public:
+    /**
+     * the number of matrices in the memory at most
+     * the target size of t1
+     */
+    size_t size, p;
+    resident t1, t2;
+    ghost b1, b2;
+    arc(int size)
+        : size(size > 0 ? size : 0)
+        , p(0)
+    {
+        if (size > 0) {
+            t1.reserve(this->size + 1);
+            t2.reserve(this->size + 1);
+            b1.reserve(this->size + 1);
+            b2.reserve(this->size + 1);
         }
-    };
+    }
 
     /**
-     * return the value connected with the key
-     * if the key not found, throw
+     * save the value_pair in the memory
+     * delete something in the memory if necessary
      */
-    T& at(const Key& key)
+    void save(const value_type& v)
     {
-        map_it it = map.find(key);
-        if (it == map.end())
-            throw index_out_of_bound();
-        list_it it2 = it->second;
-        return it2->second;
+        put(v);
+        return;
     }
-    const T& at(const Key& key) const
+    void save(value_type&& v)
     {
-        map_it it = map.find(key);
-        if (it == map.end())
-            throw index_out_of_bound();
-        list_it it2 = it->second;
-        return it2->second;
+        put(std::move(v));
+        return;
     }
-    T& operator[](const Key& key)
+    /**
+     * return a pointer contain the value
+     * a hit in t1 moves the entry (not the matrix data) to t2,
+     * the pointer stays valid until the key is saved again,
+     * hit again or evicted
+     */
+    Matrix<int>* get(const Integer& v)
     {
-        return at(key);
+        return hit(v, t1.hash(v));
     }
-    const T& operator[](const Key& key) const
+    Matrix<int>* get(int v)
     {
-        return at(key);
+        return hit(v, t1.hash(v));
     }
 
     /**
-     * return an iterator point at the beginning
-     * const or not
+     * print everything in the memory, t1 then t2
      */
-    iterator begin()
+    void print()
     {
-        return iterator(list.begin());
+        for (resident::iterator it = t1.begin(); it != t1.end(); it++)
+            std::cout << (it->first).val << " " << it->second << std::endl;
+        for (resident::iterator it = t2.begin(); it != t2.end(); it++)
+            std::cout << (it->first).val << " " << it->second << std::endl;
+        return;
     }
-    const_iterator cbegin() const
+
+private:
+    /**
+     * a save, the cases of the ARC paper in order:
+     * resident, ghost in b1, ghost in b2, and new
+     */
+    template <class V>
+    void put(V&& v)
+    {
+        if (size == 0)
+            return;
+        size_t h = t1.hash(v.first);
+        Matrix<int>* res = hit(v.first, h);
+        if (res != nullptr) {
+            *res = std::forward<V>(v).second;
+            return;
+        }
+        ghost::iterator g = b1.find(v.first, h);
+        if (g != b1.end()) {
+            size_t delta = b2.size() > b1.size() ? b2.size() / b1.size() : 1;
+            p = p + delta < size ? p + delta : size;
+            replace(false);
+            b1.remove(g);
+            t2.emplace_hashed(v.first, h, std::forward<V>(v));
+            return;
+        }
+        g = b2.find(v.first, h);
+        if (g != b2.end()) {
+            size_t delta = b1.size() > b2.size() ? b1.size() / b2.size() : 1;
+            p = p > delta ? p - delta : 0;
+            replace(true);
+            b2.remove(g);
+            t2.emplace_hashed(v.first, h, std::forward<V>(v));
+            return;
+        }
+        if (t1.size() + b1.size() == size) {
+            if (t1.size() < size) {
+                b1.remove(b1.begin());
+                replace(false);
+            } else {
+                t1.remove(t1.begin());
+            }
+        } else {
+            size_t total = t1.size() + t2.size() + b1.size() + b2.size();
+            if (total >= size) {
+                if (total == 2 * size)
+                    b2.remove(b2.begin());
+                replace(false);
+            }
+        }
+        t1.emplace_hashed(v.first, h, std::forward<V>(v));
+    }
+    /**
+     * find the key, whose mixed hash is h, in t1 and t2
+     * a found key goes to the end of t2
+     */
+    template <class K>
+    Matrix<int>* hit(const K& key, size_t h)
     {
-        return const_iterator(list.begin());
+        resident::iterator it = t2.find(key, h);
+        if (it != t2.end()) {
+            t2.move_to_back(it);
+            return &(it->second);
+        }
+        it = t1.find(key, h);
+        if (it == t1.end())
+            return nullptr;
+        resident::iterator res = t2.emplace_hashed(it->first, h, std::in_place, it->first, std::move(it->second)).first;
+        t1.remove(it);
+        return &(res->second);
     }
     /**
-     * return an iterator point at the ending
-     * const or not
+     * make room for one matrix: evict the front of t1 into b1
+     * if t1 is over its target p (or at it, for a save hitting b2),
+     * otherwise the front of t2 into b2
      */
-    iterator end()
+    void replace(bool in_b2)
     {
-        return iterator(list.end());
+        if (t1.size() > 0 && (t2.size() == 0 || t1.size() > p || (in_b2 && t1.size() == p)))
+            demote(t1, b1);
+        else if (t2.size() > 0)
+            demote(t2, b2);
     }
-    const_iterator cend() const
+    static void demote(resident& from, ghost& to)
     {
-        return const_iterator(list.end());
+        resident::iterator it = from.begin();
+        to.insert(ghost::value_type(it->first, 0));
+        from.remove(it);
     }
+};
+
+/**
+ * segmented lru cache of matrices, with the interface of lru
+ * a new key enters probation, a key hit there moves to protect,
+ * the lru of the keys used at least twice
+ * protect holds at most protect_size of the size, and its front
+ * goes back to the end of probation when it overflows
+ * only the front of probation is evicted,
+ * so keys used once in a scan never push out the keys in protect
+ */
+class slru {
+    using value_type = sjtu::pair<const Integer, Matrix<int>>;
+    using lmap = sjtu::linked_hashmap<Integer, Matrix<int>, Hash, Equal>;
 
+public:
     /**
-     * if didn't contain anything, return true,
-     * otherwise false.
+     * the number of matrices in the memory at most, and of them in protect
      */
-    bool empty() const
+    size_t size, protect_size;
+    lmap probation, protect;
+    /**
+     * ratio: the part of the size protect may hold, in [0, 1]
+     * protect keeps at least one slot for probation,
+     * or every new key would be evicted by its own save
+     */
+    slru(int size, double ratio = 0.8)
+        : size(size > 0 ? size : 0)
     {
-        return map.empty();
+        if (!(ratio >= 0 && ratio <= 1))
+            throw runtime_error();
+        protect_size = this->size * ratio;
+        if (protect_size + 1 > this->size)
+            protect_size = this->size > 0 ? this->size - 1 : 0;
+        if (size > 0) {
+            probation.reserve(this->size + 1);
+            protect.reserve(protect_size + 1);
+        }
     }
+
     /**
-     * destroy the whole linked_hashmap
-     * can't be used after destroy
+     * save the value_pair in the memory
+     * delete something in the memory if necessary
      */
-    void destroy()
+    void save(const value_type& v)
     {
-        map.destroy();
-        list.destroy();
+        put(v);
+        return;
+    }
+    void save(value_type&& v)
+    {
+        put(std::move(v));
         return;
     }
     /**
-     * clear the whole linked_hashmap
-     * can be used after clear
+     * return a pointer contain the value
+     * the pointer stays valid until the key is evicted
+     * or moves between probation and protect
      */
-    void clear()
+    Matrix<int>* get(const Integer& v)
     {
-        map.clear();
-        list.clear();
+        return hit(v, probation.hash(v));
+    }
+    Matrix<int>* get(int v)
+    {
+        return hit(v, probation.hash(v));
+    }
+
+    /**
+     * print everything in the memory, probation then protect
+     */
+    void print()
+    {
+        for (lmap::iterator it = probation.begin(); it != probation.end(); it++)
+            std::cout << (it->first).val << " " << it->second << std::endl;
+        for (lmap::iterator it = protect.begin(); it != protect.end(); it++)
+            std::cout << (it->first).val << " " << it->second << std::endl;
         return;
     }
+
+private:
+    template <class V>
+    void put(V&& v)
+    {
+        if (size == 0)
+            return;
+        size_t h = probation.hash(v.first);
+        Matrix<int>* res = hit(v.first, h);
+        if (res != nullptr) {
+            *res = std::forward<V>(v).second;
+            return;
+        }
+        probation.emplace_hashed(v.first, h, std::forward<V>(v));
+        if (probation.size() + protect.size() > size)
+            probation.remove(probation.begin());
+    }
     /**
-     * return the number of value_pairs
+     * find the key, whose mixed hash is h
+     * a key found in protect goes to its end,
+     * a key found in probation moves to the end of protect
      */
-    size_t size() const
+    template <class K>
+    Matrix<int>* hit(const K& key, size_t h)
     {
-        return map.elements;
+        lmap::iterator it = protect.touch(key, h);
+        if (it != protect.end())
+            return &(it->second);
+        it = probation.find(key, h);
+        if (it == probation.end())
+            return nullptr;
+        if (protect_size == 0) {
+            probation.move_to_back(it);
+            return &(it->second);
+        }
+        lmap::iterator res = move(probation, protect, it, h);
+        if (protect.size() > protect_size) {
+            lmap::iterator front = protect.begin();
+            move(protect, probation, front, protect.hash(front->first));
+        }
+        return &(res->second);
     }
+    /**
+     * move the node it, whose mixed hash is h, to the end of to
+     */
+    static lmap::iterator move(lmap& from, lmap& to, lmap::iterator it, size_t h)
+    {
+        lmap::iterator res = to.emplace_hashed(it->first, h, std::in_place, it->first, std::move(it->second)).first;
+        from.remove(it);
+        return res;
+    }
+};
 
+/**
+ * count-min sketch of 4-bit counters, estimating how often a key was seen
+ * a key (by its mixed hash) has depth counters, found by double hashing,
+ * and its estimate is the least of them
+ * after sample increments every counter is halved (aging),
+ * so the estimates follow the recent frequency
+ * the counters are allocated once, increment and estimate never allocate
+ */
+class frequency_sketch {
+public:
+    static constexpr size_t depth = 4;
     /**
-     * find the iterator points at the value_pair
-     * which consist of key
-     * if not find, return an iterator
-     * point at nothing
+     * the counters, 16 to a word, mask + 1 of them (a power of two)
+     * additions: the increments since the last aging
      */
-    iterator find(const Key& key)
+    unsigned long long* table;
+    size_t mask, additions, sample;
+
+    /**
+     * about 16 counters for each of the n keys expected
+     */
+    explicit frequency_sketch(size_t n)
     {
-        map_it it = map.find(key);
-        if (it == map.end())
-            return end();
-        return iterator(list_it(it->second));
+        size_t words = 1;
+        while (words < n)
+            words *= 2;
+        table = new unsigned long long[words]();
+        mask = words * 16 - 1;
+        additions = 0;
+        sample = 10 * (n > 0 ? n : 1);
+    }
+    frequency_sketch(const frequency_sketch& other)
+        : table(new unsigned long long[(other.mask + 1) / 16])
+        , mask(other.mask)
+        , additions(other.additions)
+        , sample(other.sample)
+    {
+        memcpy(table, other.table, (mask + 1) / 2);
+    }
+    frequency_sketch(frequency_sketch&& other) noexcept
+        : table(other.table)
+        , mask(other.mask)
+        , additions(other.additions)
+        , sample(other.sample)
+    {
+        other.table = nullptr;
+    }
+    ~frequency_sketch()
+    {
+        delete[] table;
     }
+    frequency_sketch& operator=(frequency_sketch other) noexcept
+    {
+        std::swap(table, other.table);
+        std::swap(mask, other.mask);
+        std::swap(additions, other.additions);
+        std::swap(sample, other.sample);
+        return *this;
+    }
+
     /**
-     * return how many value_pairs consist of the key
-     * should only return 0 or 1
+     * count one more use of the key whose mixed hash is h
      */
-    size_t count(const Key& key) const
+    void increment(size_t h)
     {
-        map_it it = map.find(key);
-        return it != map.end();
+        size_t step = (h >> 32) | 1;
+        for (size_t i = 0; i < depth; i++, h += step) {
+            size_t pos = h & mask;
+            unsigned long long& word = table[pos >> 4];
+            unsigned shift = (pos & 15) * 4;
+            if (((word >> shift) & 15) != 15)
+                word += 1ULL << shift;
+        }
+        if (++additions == sample)
+            age();
     }
     /**
-     * insert a new key
-     * already have a value_pair with the same key:
-     * just update the value, return false
-     * and move the value_pair to the end of the list
-     * not find a value_pair with the same key:
-     * insert the value_pair, return true
+     * return the estimated uses of the key whose mixed hash is h, at most 15
      */
-    pair<iterator, bool> insert(const value_type& value)
+    unsigned estimate(size_t h) const
     {
-        map_it it = map.find(value.first);
-        if (it == map.end()) {
-            list.insert_tail(value);
-            list_it it2 = list.last();
-            map.insert({ value.first, it2 });
-            return sjtu::pair<iterator, bool>(iterator(list_it(it2)), true);
-        } else {
-            list_it it2 = it->second;
-            list.erase(it2);
-            list.insert_tail(value);
-            it2 = list.last();
-            map.insert({ value.first, it2 });
-            return sjtu::pair<iterator, bool>(iterator(list_it(it2)), false);
+        size_t step = (h >> 32) | 1;
+        unsigned res = 15;
+        for (size_t i = 0; i < depth; i++, h += step) {
+            size_t pos = h & mask;
+            unsigned count = (table[pos >> 4] >> ((pos & 15) * 4)) & 15;
+            if (count < res)
+                res = count;
         }
+        return res;
     }
     /**
-     * erase the element at iterator pos
-     * if the iter didn't point to anything, throw
+     * halve every counter
      */
-    void remove(iterator pos)
+    void age()
     {
-        list_it it = pos.p;
-        if (it == list.end())
-            throw invalid_iterator();
-        map.remove(it->first);
-        list.erase(it);
-        return;
+        for (size_t i = 0; i <= mask / 16; i++)
+            table[i] = (table[i] >> 1) & 0x7777777777777777ULL;
+        additions /= 2;
     }
 };
 
-class lru {
-    using lmap = sjtu::linked_hashmap<Integer, Matrix<int>, Hash, Equal>;
+/**
+ * W-TinyLFU cache of matrices, with the interface of lru
+ * a new key first enters window, a small lru of about 1% of the size
+ * the key pushed out of window (the candidate) joins main, the lru
+ * of the rest, only while main has room or if the sketch estimates it
+ * more frequent than the front (the victim) of main,
+ * which is then evicted instead of the candidate
+ * so a burst of keys used once passes through window
+ * and leaves the frequent keys of main in the memory
+ * every hit and every save counts the key in the sketch (a miss does not,
+ * so a get that misses and the save after it count the key once)
+ */
+class tinylfu {
     using value_type = sjtu::pair<const Integer, Matrix<int>>;
+    using lmap = sjtu::linked_hashmap<Integer, Matrix<int>, Hash, Equal>;
 
 public:
     /**
-     * the size of the list
-     * pop if the list is full
+     * the number of matrices in the memory at most, and of them in window
      */
-    size_t size;
-    lmap map;
-    lru(int size)
-        : size(size)
+    size_t size, window_size;
+    lmap window, main;
+    frequency_sketch sketch;
+    tinylfu(int size)
+        : size(size > 0 ? size : 0)
+        , window_size(size > 0 ? size / 100 + 1 : 0)
+        , sketch(this->size)
     {
+        if (size > 0) {
+            window.reserve(window_size + 1);
+            main.reserve(this->size - window_size + 1);
+        }
     }
-    ~lru() = default;
 
     /**
      * save the value_pair in the memory
@@ -973,36 +5177,96 @@ public:
      */
     void save(const value_type& v)
     {
-        map.insert(v);
-        if (map.size() > size) {
-            lmap::iterator it = map.begin();
-            map.remove(it);
-        }
+        put(v);
+        return;
+    }
+    void save(value_type&& v)
+    {
+        put(std::move(v));
         return;
     }
     /**
      * return a pointer contain the value
+     * the pointer stays valid until the key is evicted
+     * or moved from window to main
      */
     Matrix<int>* get(const Integer& v)
     {
-        lmap::iterator it = map.find(v);
-        if (it != map.end()) {
-            map.insert(value_type(it->first, it->second));
-            it = map.find(v);
-            return &(it->second);
-        }
-        return nullptr;
+        return hit(v, window.hash(v));
+    }
+    Matrix<int>* get(int v)
+    {
+        return hit(v, window.hash(v));
     }
 
     /**
-     * print everything in the memory
+     * print everything in the memory, window then main
      */
     void print()
     {
-        for (lmap::iterator it = map.begin(); it != map.end(); it++)
+        for (lmap::iterator it = window.begin(); it != window.end(); it++)
+            std::cout << (it->first).val << " " << it->second << std::endl;
+        for (lmap::iterator it = main.begin(); it != main.end(); it++)
             std::cout << (it->first).val << " " << it->second << std::endl;
         return;
     }
+
+private:
+    template <class V>
+    void put(V&& v)
+    {
+        if (size == 0)
+            return;
+        size_t h = window.hash(v.first);
+        Matrix<int>* res = hit(v.first, h);
+        if (res != nullptr) {
+            *res = std::forward<V>(v).second;
+            return;
+        }
+        sketch.increment(h);
+        window.emplace_hashed(v.first, h, std::forward<V>(v));
+        if (window.size() > window_size)
+            admit();
+    }
+    /**
+     * find the key, whose mixed hash is h, in window and main
+     * a found key goes to the end of its lru and is counted in the sketch
+     */
+    template <class K>
+    Matrix<int>* hit(const K& key, size_t h)
+    {
+        lmap::iterator it = window.touch(key, h);
+        if (it != window.end()) {
+            sketch.increment(h);
+            return &(it->second);
+        }
+        it = main.touch(key, h);
+        if (it != main.end()) {
+            sketch.increment(h);
+            return &(it->second);
+        }
+        return nullptr;
+    }
+    /**
+     * take the candidate out of window,
+     * and let it into main if main has room or it beats the victim
+     */
+    void admit()
+    {
+        lmap::iterator candidate = window.begin();
+        size_t h = window.hash(candidate->first);
+        bool admitted = main.size() < size - window_size;
+        if (!admitted && main.size() > 0) {
+            lmap::iterator victim = main.begin();
+            if (sketch.estimate(h) > sketch.estimate(main.hash(victim->first))) {
+                main.remove(victim);
+                admitted = true;
+            }
+        }
+        if (admitted)
+            main.emplace_hashed(candidate->first, h, std::in_place, candidate->first, std::move(candidate->second));
+        window.remove(candidate);
+    }
 };
 }
 
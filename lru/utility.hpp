@@ -23,8 +23,17 @@ public:
     }
     template <class U1, class U2>
     pair(U1&& x, U2&& y)
-        : first(x)
-        , second(y)
+        : first(std::forward<U1>(x))
+        , second(std::forward<U2>(y))
+    {
+    }
+    /**
+     * construct first from x and second from args in place
+     */
+    template <class U1, class... Args>
+    pair(std::in_place_t, U1&& x, Args&&... args)
+        : first(std::forward<U1>(x))
+        , second(std::forward<Args>(args)...)
     {
     }
     template <class U1, class U2>
@@ -35,8 +44,8 @@ public:
     }
     template <class U1, class U2>
     pair(pair<U1, U2>&& other)
-        : first(other.first)
-        , second(other.second)
+        : first(std::forward<U1>(other.first))
+        , second(std::forward<U2>(other.second))
     {
     }
 };
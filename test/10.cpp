@@ -0,0 +1,203 @@
+#include "src.hpp"
+#if defined(_UNORDERED_MAP_) || (defined(_LIST_)) || (defined(_MAP_)) || (defined(_SET_)) || (defined(_UNORDERED_SET_)) || (defined(_GLIBCXX_MAP)) || (defined(_GLIBCXX_UNORDERED_MAP))
+BOOM :)
+#endif
+#include <iostream>
+#include <string>
+#include <vector>
+
+std::string c[]={
+    "   pass!",
+    "   error.",
+    "test1: a full group goes on to the first group",
+    "test2: remove in a full group leaves a deleted slot",
+    "test3: the deleted slots are dropped without growing",
+    "test4: rehash rounds up to a power of two",
+    "test5: memcheck",
+    "Congratulations. Your submission has passed all correctness tests. Good job! :)",
+};
+
+using map_type = sjtu::swiss_hashmap<int, int>;
+
+void result(bool ok)
+{
+    std::cout << (ok ? c[0] : c[1]) << std::endl;
+}
+
+/**
+ * the group a probe for key starts from
+ */
+size_t home(const map_type& map, int key)
+{
+    return (sjtu::hash_mix(std::hash<int>()(key)) >> 7) & map.mask;
+}
+
+/**
+ * the slot key is in
+ */
+size_t slot(const map_type& map, int key)
+{
+    return map.find(key).at() - map.table;
+}
+
+/**
+ * n keys from first whose probes start from group g
+ */
+std::vector<int> keys_of(const map_type& map, size_t g, size_t n, int first = 0)
+{
+    std::vector<int> keys;
+    for (int key = first; keys.size() < n; key++) {
+        if (home(map, key) == g)
+            keys.push_back(key);
+    }
+    return keys;
+}
+
+/**
+ * whether the keys [first, last) are found with value key * 2
+ */
+bool holds(const map_type& map, int first, int last)
+{
+    bool ok = true;
+    for (int i = first; i < last; i++) {
+        map_type::iterator it = map.find(i);
+        ok &= it != map.end() && it->second == i * 2;
+    }
+    return ok;
+}
+
+void wrap_tester()
+{
+    std::cout << c[2];
+    map_type map;
+    map.rehash(2);
+    bool ok = map.mask == 1;
+    // 16 keys fill the last group, the 17th is put in group 0
+    std::vector<int> keys = keys_of(map, 1, 18);
+    for (int i = 0; i < 17; i++)
+        map.insert(map_type::value_type(keys[i], i));
+    ok &= map.mask == 1 && map.elements == 17;
+    for (int i = 0; i < 16; i++)
+        ok &= slot(map, keys[i]) / map.group_size == 1 && map.find(keys[i])->second == i;
+    ok &= slot(map, keys[16]) / map.group_size == 0 && map.find(keys[16])->second == 16;
+    // a miss goes on to group 0 as well, and stops at its empty slots
+    ok &= map.find(keys[17]) == map.end();
+    result(ok);
+}
+
+void tombstone_tester()
+{
+    std::cout << c[3];
+    map_type map;
+    map.rehash(2);
+    std::vector<int> keys = keys_of(map, 1, 18);
+    for (int i = 0; i < 17; i++)
+        map.insert(map_type::value_type(keys[i], i));
+    size_t pos = slot(map, keys[3]);
+    // group 1 is full, a probe for keys[16] must not stop at the removed slot
+    map.remove(keys[3]);
+    bool ok = map.deleted == 1 && map.ctrl[pos] == map.ctrl_deleted && map.find(keys[3]) == map.end();
+    ok &= map.find(keys[16]) != map.end() && map.find(keys[16])->second == 16;
+    // group 0 has empty slots, so its slot is simply empty again
+    size_t last = slot(map, keys[16]);
+    map.remove(keys[16]);
+    ok &= map.deleted == 1 && map.ctrl[last] == map.ctrl_empty;
+    // the next key of group 1 takes the deleted slot
+    map.insert(map_type::value_type(keys[17], 17));
+    ok &= map.deleted == 0 && slot(map, keys[17]) == pos && map.find(keys[17])->second == 17;
+    ok &= map.elements == 16 && map.find(keys[0])->second == 0;
+    result(ok);
+}
+
+void churn_tester()
+{
+    std::cout << c[4];
+    map_type map;
+    map.rehash(64);
+    const int live = 400;
+    for (int i = 0; i < live; i++)
+        map.insert(map_type::value_type(i, i * 2));
+    bool ok = map.mask == 63;
+    size_t slots = (map.mask + 1) * map.group_size;
+    size_t most = 0;
+    // every remove in a full group leaves a deleted slot,
+    // they are dropped by a rehash of the same size before the table fills
+    for (int i = live; i < 200000; i++) {
+        map.insert(map_type::value_type(i, i * 2));
+        map.remove(i - live);
+        ok &= map.mask == 63 && map.elements == live && (map.elements + map.deleted) * 8 <= slots * 7;
+        if (map.deleted > most)
+            most = map.deleted;
+    }
+    ok &= most > 0 && holds(map, 200000 - live, 200000) && map.find(200000 - live - 1) == map.end();
+    // an explicit rehash drops them as well
+    map.rehash(64);
+    ok &= map.deleted == 0 && map.mask == 63 && holds(map, 200000 - live, 200000);
+    result(ok);
+}
+
+void round_tester()
+{
+    std::cout << c[5];
+    map_type map;
+    for (int i = 0; i < 100; i++)
+        map.insert(map_type::value_type(i, i * 2));
+    map.rehash(9);
+    bool ok = map.mask == 15 && holds(map, 0, 100);
+    map.rehash(16);
+    ok &= map.mask == 15 && holds(map, 0, 100);
+    // too few groups for the elements: rounded up to the least that hold them
+    map.rehash(3);
+    ok &= map.mask == 7 && holds(map, 0, 100);
+    map.rehash(0);
+    ok &= map.mask == 7 && holds(map, 0, 100);
+    for (int i = 100; i < 1000; i++)
+        map.insert(map_type::value_type(i, i * 2));
+    ok &= holds(map, 0, 1000) && ((map.mask + 1) & map.mask) == 0;
+    map_type empty;
+    empty.rehash(0);
+    ok &= empty.mask == 0;
+    empty.insert(map_type::value_type(1, 2));
+    ok &= holds(empty, 1, 2);
+    result(ok);
+}
+
+void memcheck_tester()
+{
+    std::cout << c[6];
+    using mp = sjtu::swiss_hashmap<Integer, Matrix<int>, Hash, Equal>;
+    using value_type = sjtu::pair<Integer, Matrix<int>>;
+    bool ok = true;
+    {
+        mp map;
+        for (int i = 0; i < 3000; i++)
+            map.insert(value_type(Integer(i), Matrix<int>(1, 2, i)));
+        for (int i = 0; i < 3000; i += 2)
+            map.remove(Integer(i));
+        mp copy(map);
+        copy.rehash(5);
+        for (int i = 0; i < 3000; i++) {
+            mp::iterator it = copy.find(Integer(i));
+            ok &= (it == copy.end()) == (i % 2 == 0);
+            ok &= it == copy.end() || it->second == Matrix<int>(1, 2, i);
+        }
+        map = copy;
+        map.clear();
+        map.insert(value_type(Integer(1), Matrix<int>(1, 1, 1)));
+    }
+    ok &= Integer::counter == 0;
+    result(ok);
+}
+
+int main()
+{
+#ifdef _OUTPUT_
+    freopen("10.out", "w", stdout);
+#endif
+    wrap_tester();
+    tombstone_tester();
+    churn_tester();
+    round_tester();
+    memcheck_tester();
+    std::cout << c[7] << std::endl;
+}
@@ -0,0 +1,420 @@
+#include "src.hpp"
+#if defined(_UNORDERED_MAP_) || (defined(_LIST_)) || (defined(_MAP_)) || (defined(_SET_)) || (defined(_UNORDERED_SET_)) || (defined(_GLIBCXX_MAP)) || (defined(_GLIBCXX_UNORDERED_MAP))
+BOOM :)
+#endif
+#include <cassert>
+#include <iostream>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+// if this is 1, output yes or no
+// otherwise, output the exact num
+#define STATUS 0
+
+std::string c[]={
+    "   pass!",
+    "   error.",
+    "test1: constructor",
+    "test2: insert & expand",
+    "test3: remove",
+    "test4: find & correctness of insert and remove",
+    "test5: clear",
+    "Congratulations. Your submission has passed all correctness tests. Good job! :)",
+    "test6: constructor(), =",
+    "test const iterator",
+    "test7: copy on write",
+};
+
+bool exists(sjtu::hashmap<int, int> map, sjtu::hashmap<int, int>::iterator i)
+{
+    return i != map.end();
+}
+
+bool equal(Integer a, Integer b)
+{
+    return a.val == b.val;
+}
+
+void Integer_linked_hashmap_tester()
+{
+    using value_type = sjtu::pair<Integer, Integer>;
+    using mp = sjtu::compact_linked_hashmap<Integer, Integer, Hash, Equal>;
+    using test_type = std::unordered_map<Integer, Integer, Hash, Equal>;
+    const int n = 4000;
+    // test: constructor
+    if (STATUS)
+        std::cout << c[2];
+    mp map;
+    test_type ref;
+    std::list<Integer> order;
+    if (STATUS)
+        std::cout << c[0] << std::endl;
+
+    // test: insert,remove and expand
+    if (STATUS)
+        std::cout << c[3];
+    for (int i = 0; i < n; i++) {
+        map.insert(value_type(Integer(i), Integer(i)));
+        ref.insert(std::pair<Integer, Integer>(Integer(i), Integer(i)));
+        order.push_back(Integer(i));
+    }
+
+    if (STATUS)
+        std::cout << std::endl
+                  << c[4]; // test remove
+    for (mp::iterator it = map.begin(); it != map.end(); it++) {
+        order.remove((*it).first);
+        ref.erase((*it).first);
+        mp::iterator tmpit = it;
+        it++;
+        map.remove(tmpit);
+        if (it == map.end()) {
+            break;
+        }
+        it++;
+        if (it == map.end()) {
+            break;
+        }
+    }
+    if (STATUS)
+        std::cout << c[0] << std::endl;
+    for (int i = 0; i < n; i += 4) {
+        map.insert(value_type(Integer(i), Integer(4 * i)));
+        ref.insert(std::pair<Integer, Integer>(Integer(i), Integer(4 * i)));
+        order.remove(Integer(i));
+        order.push_back(Integer(i));
+    }
+    if (STATUS)
+        std::cout << c[0] << std::endl;
+
+    // test: counter
+
+    int ct = 0;
+    for (int i = 0; i < n; i++) {
+        ct += map.count(Integer(i));
+    }
+    std::cout << ct << std::endl;
+
+    // test: iterator
+    mp::iterator it = map.begin();
+    std::list<Integer>::iterator lit = order.begin();
+    while (it != map.end()) {
+        std::cout << (*it).first.val << " " << (*it).second.val << " " << (*lit).val << " " << (*(ref.find(*lit))).second.val << std::endl;
+        it++;
+        lit++;
+    }
+
+    // test: const iterator
+
+    if (STATUS)
+        std::cout << c[9];
+    mp::iterator iter;
+    iter = map.begin();
+    iter = map.end();
+    mp::const_iterator const_iter;
+    const_iter = map.cend();
+    const_iter = map.cbegin();
+    if (STATUS)
+        std::cout << c[0] << std::endl;
+    // test: find
+    if (STATUS)
+        std::cout << c[5];
+    for (int i = 0; i < n; i++) {
+        mp::iterator it = map.find(Integer(i));
+        if (STATUS == 0) {
+            if (it != map.end())
+                std::cout << (*it).second.val << std::endl;
+        }
+        if (i % 3 == 0 && i % 4 != 0) {
+            if (it != map.end()) {
+                std::cout << c[1] << std::endl;
+                exit(0);
+            }
+        } else if (i % 4 == 0) {
+            if (!equal(Integer(4 * i), (*it).second)) {
+                std::cout << c[1] << std::endl;
+                exit(0);
+            }
+        } else {
+            if (!equal(Integer(i), (*it).second)) {
+                std::cout << c[1] << std::endl;
+                exit(0);
+            }
+        }
+    }
+    if (STATUS)
+        std::cout << c[0] << std::endl;
+
+    // test: constructor(), =
+    if (STATUS)
+        std::cout << c[8];
+    mp map2(map);
+    map2.clear();
+    map2 = map;
+    for (int i = 0; i < n; i++) {
+        mp::iterator it = map2.find(Integer(i));
+        if (i % 3 == 0 && i % 4 != 0) {
+            if (it != map2.end()) {
+                std::cout << c[1] << std::endl;
+                exit(0);
+            }
+        } else if (i % 4 == 0) {
+            if (!equal(Integer(4 * i), (*it).second)) {
+                std::cout << c[1] << std::endl;
+                exit(0);
+            }
+        } else {
+            if (!equal(Integer(i), (*it).second)) {
+                std::cout << c[1] << std::endl;
+                exit(0);
+            }
+        }
+    }
+    if (STATUS)
+        std::cout << c[0] << std::endl;
+
+    // test: clear
+    if (STATUS)
+        std::cout << c[6];
+    map.clear();
+    map.clear();
+    if (STATUS)
+        std::cout << c[0] << std::endl;
+}
+
+void Matrix_linked_hashmap_tester()
+{
+    using mType = Matrix<int>;
+    using value_type = sjtu::pair<Integer, mType>;
+    using mp = sjtu::compact_linked_hashmap<Integer, mType, Hash, Equal>;
+    const int n = 100;
+    // test: constructor
+    if (STATUS)
+        std::cout << c[2];
+    mp map;
+    if (STATUS)
+        std::cout << c[0] << std::endl;
+
+    // test: insert,remove and expand
+    if (STATUS)
+        std::cout << c[3];
+    for (int i = 0; i < n; i++) {
+        map.insert(value_type(Integer(i), mType(2, 2, i)));
+    }
+    if (STATUS)
+        std::cout << std::endl
+                  << c[4]; // test remove
+
+    for (mp::iterator it = map.begin(); it != map.end(); it++) {
+        mp::iterator tmpit = it;
+        it++;
+        map.remove(tmpit);
+        if (it == map.end()) {
+            break;
+        }
+        it++;
+        if (it == map.end()) {
+            break;
+        }
+    }
+
+    for (int i = 0; i < n; i += 4) {
+        map.insert(value_type(Integer(i), mType(2, 2, 4 * i)));
+    }
+    if (STATUS)
+        std::cout << c[0] << std::endl;
+
+    // test: counter
+
+    int ct = 0;
+    for (int i = 0; i < n; i++) {
+        ct += map.count(Integer(i));
+    }
+    std::cout << ct << std::endl;
+
+    // test: iterator
+    mp::iterator it = map.begin();
+    while (it != map.end()) {
+        std::cout << (*it).first.val << " " << (*it).second << std::endl;
+        it++;
+    }
+
+    // test: const iterator
+
+    if (STATUS)
+        std::cout << c[9];
+    mp::iterator iter;
+    iter = map.begin();
+    iter = map.end();
+    mp::const_iterator const_iter;
+    const_iter = map.cend();
+    const_iter = map.cbegin();
+    if (STATUS)
+        std::cout << c[0] << std::endl;
+
+    // test: find
+    if (STATUS)
+        std::cout << c[5];
+    for (int i = 0; i < n; i++) {
+        mp::iterator it = map.find(Integer(i));
+        if (STATUS == 0) {
+            if (it != map.end())
+                std::cout << (*it).second << std::endl;
+        }
+        if (i % 3 == 0 && i % 4 != 0) {
+            if (it != map.end()) {
+                std::cout << c[1] << std::endl;
+                exit(0);
+            }
+        } else if (i % 4 == 0) {
+            if (!(mType(2, 2, 4 * i) == (*it).second)) {
+                std::cout << c[1] << std::endl;
+                exit(0);
+            }
+        } else {
+            if (!(mType(2, 2, i) == (*it).second)) {
+                std::cout << c[1] << std::endl;
+                exit(0);
+            }
+        }
+    }
+    if (STATUS)
+        std::cout << c[0] << std::endl;
+
+    // test: constructor(), =
+    if (STATUS)
+        std::cout << c[8];
+    mp map2(map);
+    map2.clear();
+    map2 = map;
+    for (int i = 0; i < n; i++) {
+        mp::iterator it = map2.find(Integer(i));
+        if (i % 3 == 0 && i % 4 != 0) {
+            if (it != map2.end()) {
+                std::cout << c[1] << std::endl;
+                exit(0);
+            }
+        } else if (i % 4 == 0) {
+            if (!(mType(2, 2, 4 * i) == (*it).second)) {
+                std::cout << c[1] << std::endl;
+                exit(0);
+            }
+        } else {
+            if (!(mType(2, 2, i) == (*it).second)) {
+                std::cout << c[1] << std::endl;
+                exit(0);
+            }
+        }
+    }
+    if (STATUS)
+        std::cout << c[0] << std::endl;
+
+    // test: clear
+    if (STATUS)
+        std::cout << c[6];
+    map.clear();
+    map.clear();
+    if (STATUS)
+        std::cout << c[0] << std::endl;
+}
+
+/**
+ * the contents of map should be exactly those of ref, in any order
+ */
+template <class Map>
+bool same(const Map& map, const std::unordered_map<Integer, int, Hash, Equal>& ref)
+{
+    if (map.size() != ref.size())
+        return false;
+    for (auto& [key, value] : ref)
+        if (map.count(key) != 1 || map.at(key) != value)
+            return false;
+    size_t ct = 0;
+    for (typename Map::const_iterator it = map.cbegin(); it != map.cend(); ++it)
+        ct++;
+    return ct == ref.size();
+}
+
+void cow_tester()
+{
+    using value_type = sjtu::pair<const Integer, int>;
+    using mp = sjtu::compact_linked_hashmap<Integer, int, Hash, Equal>;
+    using test_type = std::unordered_map<Integer, int, Hash, Equal>;
+    std::cout << c[10];
+    bool ok = true;
+    int alive = Integer::counter;
+    {
+        mp map;
+        test_type ref;
+        for (int i = 0; i < 3000; i++) {
+            map.insert(value_type(Integer(i), i));
+            ref.emplace(Integer(i), i);
+        }
+        mp* copy = new mp(map);
+        test_type copy_ref = ref;
+        ok &= copy->chunks[0] == map.chunks[0] && map.chunks[0]->refs == 2;
+        // reading either map through the iterators, find and at copies nothing
+        long long sum = 0;
+        for (mp::iterator it = map.begin(); it != map.end(); ++it)
+            sum += it->second + (*it).first.val;
+        for (int i = 0; i < 3000; i++)
+            sum += copy->find(Integer(i))->second + copy->at(Integer(i)) + map.at(i);
+        ok &= sum == 5LL * 2999 * 3000 / 2;
+        for (size_t k = 0; k < map.chunk_count; k++)
+            ok &= map.chunks[k] == copy->chunks[k] && map.chunks[k]->refs == 2;
+
+        // the original grows over two more chunks, loses and overwrites some
+        for (int i = 3000; i < 5500; i++) {
+            map.insert(value_type(Integer(i), i));
+            ref.emplace(Integer(i), i);
+        }
+        for (int i = 0; i < 1000; i += 2) {
+            map.remove(map.find(Integer(i)));
+            ref.erase(Integer(i));
+        }
+        for (int i = 1; i < 3000; i += 6) {
+            map.modify(map.find(Integer(i))) = -i;
+            ref[Integer(i)] = -i;
+        }
+        // the copy does the same to other keys
+        for (int i = 0; i < 3000; i += 5) {
+            copy->remove(copy->find(Integer(i)));
+            copy_ref.erase(Integer(i));
+        }
+        for (int i = 10000; i < 11500; i++) {
+            copy->insert(value_type(Integer(i), i));
+            copy_ref.emplace(Integer(i), i);
+        }
+        for (mp::iterator it = copy->begin(); it != copy->end(); ++it)
+            if ((*it).first.val % 7 == 0) {
+                copy->modify(it) = 7;
+                copy_ref[(*it).first] = 7;
+            }
+        ok &= same(map, ref) && same(*copy, copy_ref);
+
+        // dropping either one leaves the other whole
+        mp other(*copy);
+        ok &= other.chunks[0]->refs == 2;
+        delete copy;
+        ok &= other.chunks[0]->refs == 1 && same(other, copy_ref);
+        mp last(map);
+        map = other;
+        ok &= same(map, copy_ref) && same(last, ref);
+        for (size_t k = 0; k < last.chunk_count; k++)
+            ok &= last.chunks[k]->refs == 1;
+    }
+    ok &= Integer::counter == alive;
+    std::cout << (ok ? c[0] : c[1]) << std::endl;
+}
+
+int main()
+{
+#ifdef _OUTPUT_
+    freopen("11.out", "w", stdout);
+#endif
+    Integer_linked_hashmap_tester();
+    // Matrix_linked_hashmap_tester();
+    cow_tester();
+    std::cout << c[7] << std::endl;
+}
@@ -0,0 +1,288 @@
+#include "src.hpp"
+#if defined(_UNORDERED_MAP_) || (defined(_LIST_)) || (defined(_MAP_)) || (defined(_SET_)) || (defined(_UNORDERED_SET_)) || (defined(_GLIBCXX_MAP)) || (defined(_GLIBCXX_UNORDERED_MAP))
+BOOM :)
+#endif
+#include <iostream>
+#include <random>
+#include <string>
+
+std::string c[]={
+    "   pass!",
+    "   error.",
+    "test1: fifo ignores hits",
+    "test2: clock gives a second chance",
+    "test3: random keeps the size",
+    "test4: arc keeps the hot keys through a scan",
+    "test5: arc bounds of t1, t2, b1, b2",
+    "test6: byte_lru evicts until the bytes fit",
+    "test7: clock keeps the new key when all are referenced",
+    "test8: random evicts uniformly, also from copies",
+    "test9: random works with any key",
+    "test10: an arc with a negative size holds nothing",
+    "test11: an lru with a negative size holds nothing",
+    "Congratulations. Your submission has passed all correctness tests. Good job! :)",
+};
+
+using value_type = sjtu::pair<Integer, Matrix<int>>;
+
+void result(bool ok)
+{
+    std::cout << (ok ? c[0] : c[1]) << std::endl;
+}
+
+/**
+ * save n keys (0 to n - 1) into a cache of size n,
+ * get key 0, then save key n
+ */
+template <class Cache>
+Cache fill(int n)
+{
+    Cache cache(n);
+    for (int i = 0; i < n; i++)
+        cache.save(value_type(Integer(i), Matrix<int>(1, 1, i)));
+    cache.get(0);
+    cache.save(value_type(Integer(n), Matrix<int>(1, 1, n)));
+    return cache;
+}
+
+void fifo_tester()
+{
+    std::cout << c[2];
+    sjtu::fifo_cache cache = fill<sjtu::fifo_cache>(10);
+    result(cache.get(0) == nullptr && cache.get(1) != nullptr && cache.get(10) != nullptr);
+}
+
+void clock_tester()
+{
+    std::cout << c[3];
+    sjtu::clock_cache cache = fill<sjtu::clock_cache>(10);
+    result(cache.get(0) != nullptr && cache.get(1) == nullptr && cache.get(10) != nullptr);
+}
+
+void random_tester()
+{
+    std::cout << c[4];
+    sjtu::random_cache cache(100);
+    bool ok = true;
+    for (int i = 0; i < 10000; i++) {
+        cache.save(value_type(Integer(i), Matrix<int>(1, 1, i)));
+        ok &= cache.map.size() == size_t(i < 100 ? i + 1 : 100);
+        ok &= cache.get(i) != nullptr;
+    }
+    result(ok);
+}
+
+/**
+ * every round gets hot keys, then scans twice the size of new keys once
+ * return how many gets of the hot keys hit
+ */
+template <class Cache>
+int scan_hits(int n)
+{
+    Cache cache(n);
+    std::mt19937 rng(2024);
+    int hits = 0, scan = n;
+    for (int round = 0; round < 10; round++) {
+        for (int i = 0; i < 10 * n; i++) {
+            int key = rng() % (n / 2);
+            if (cache.get(key) != nullptr)
+                hits++;
+            else
+                cache.save(value_type(Integer(key), Matrix<int>(1, 1, key)));
+        }
+        for (int i = 0; i < 2 * n; i++, scan++) {
+            if (cache.get(scan) == nullptr)
+                cache.save(value_type(Integer(scan), Matrix<int>()));
+        }
+    }
+    return hits;
+}
+
+void arc_scan_tester()
+{
+    std::cout << c[5];
+    int arc_hits = scan_hits<sjtu::arc>(200);
+    int lru_hits = scan_hits<sjtu::lru>(200);
+    result(arc_hits > lru_hits && arc_hits > 20000 - 200);
+}
+
+void arc_bound_tester()
+{
+    std::cout << c[6];
+    std::mt19937 rng(7);
+    bool ok = true;
+    for (size_t n : {1, 2, 5, 17, 64}) {
+        sjtu::arc cache(n);
+        for (int i = 0; i < 20000; i++) {
+            int key = rng() % 4 == 0 ? rng() % (n * 8) : rng() % (n + 3);
+            if (rng() % 2 == 0)
+                cache.get(key);
+            else
+                cache.save(value_type(Integer(key), Matrix<int>(1, 1, key)));
+            ok &= cache.t1.size() + cache.t2.size() <= n;
+            ok &= cache.t1.size() + cache.b1.size() <= n;
+            ok &= cache.t1.size() + cache.t2.size() + cache.b1.size() + cache.b2.size() <= 2 * n;
+            ok &= cache.p <= n;
+        }
+    }
+    result(ok);
+}
+
+void byte_tester()
+{
+    std::cout << c[7];
+    sjtu::byte_weigher weigher;
+    size_t small = weigher(Integer(0), Matrix<int>(2, 2)), big = weigher(Integer(0), Matrix<int>(20, 20));
+    sjtu::byte_lru cache(10 * small);
+    bool ok = true;
+    for (int i = 0; i < 10; i++)
+        cache.save(value_type(Integer(i), Matrix<int>(2, 2, i)));
+    ok &= cache.map.size() == 10 && cache.weight == 10 * small;
+    cache.get(0);
+    cache.save(value_type(Integer(10), Matrix<int>(8, 8, 10)));
+    ok &= cache.map.size() == 7 && cache.weight <= cache.size;
+    ok &= cache.get(0) != nullptr && cache.get(1) == nullptr && cache.get(4) == nullptr && cache.get(5) != nullptr;
+    // a value heavier than the whole budget leaves the others alone
+    size_t weight = cache.weight;
+    cache.save(value_type(Integer(11), Matrix<int>(20, 20, 11)));
+    ok &= big > cache.size && cache.map.size() == 7 && cache.weight == weight;
+    ok &= cache.get(11) == nullptr && cache.get(0) != nullptr;
+    cache.save(value_type(Integer(0), Matrix<int>(20, 20, 0)));
+    ok &= cache.get(0) == nullptr && cache.map.size() == 6;
+    // the rows of a tall matrix weigh their vectors too
+    ok &= weigher(Integer(0), Matrix<int>(100, 1)) >= 100 * (sizeof(int) + sizeof(std::vector<int>));
+    std::mt19937 rng(11);
+    for (int i = 0; i < 20000; i++) {
+        int key = rng() % 50;
+        size_t rows = rng() % 8 + 1;
+        cache.save(value_type(Integer(key), Matrix<int>(rows, 2, key)));
+        size_t total = 0;
+        for (auto it = cache.map.begin(); it != cache.map.end(); it++)
+            total += weigher(it->first, it->second.value);
+        ok &= total == cache.weight && cache.weight <= cache.size;
+    }
+    result(ok);
+}
+
+void clock_referenced_tester()
+{
+    std::cout << c[8];
+    sjtu::clock_cache cache(3);
+    for (int i = 0; i < 3; i++)
+        cache.save(value_type(Integer(i), Matrix<int>(1, 1, i)));
+    for (int i = 0; i < 3; i++)
+        cache.get(i);
+    cache.save(value_type(Integer(3), Matrix<int>(1, 1, 3)));
+    bool ok = cache.get(3) != nullptr && cache.map.size() == 3;
+    ok &= cache.get(0) == nullptr && cache.get(1) != nullptr && cache.get(2) != nullptr;
+    sjtu::clock_cache single(1);
+    for (int i = 0; i < 10; i++) {
+        single.save(value_type(Integer(i), Matrix<int>(1, 1, i)));
+        ok &= single.get(i) != nullptr && single.map.size() == 1;
+    }
+    result(ok);
+}
+
+void random_uniform_tester()
+{
+    std::cout << c[9];
+    sjtu::random_cache base(10);
+    for (int i = 0; i < 10; i++)
+        base.save(value_type(Integer(i), Matrix<int>(1, 1, i)));
+    int evicted[10] = {};
+    bool ok = true;
+    for (int t = 0; t < 10000; t++) {
+        sjtu::random_cache cache(base);
+        cache.policy.state += t * 2;
+        cache.save(value_type(Integer(10), Matrix<int>(1, 1, 10)));
+        ok &= cache.get(10) != nullptr && cache.map.size() == 10;
+        for (int i = 0; i < 10; i++)
+            evicted[i] += cache.get(i) == nullptr;
+    }
+    for (int i = 0; i < 10; i++)
+        ok &= evicted[i] > 800 && evicted[i] < 1200;
+    std::mt19937 rng(3);
+    sjtu::random_cache cache(50);
+    for (int i = 0; i < 20000; i++) {
+        int key = rng() % 200;
+        if (rng() % 4 == 0)
+            cache.erase(key);
+        else
+            cache.save(value_type(Integer(key), Matrix<int>(1, 1, key)));
+    }
+    ok &= cache.policy.count == cache.map.size();
+    for (size_t i = 0; i < cache.policy.count; i++)
+        ok &= cache.map.find(cache.policy.keys[i])->second.position == i;
+    result(ok);
+}
+
+void random_key_tester()
+{
+    std::cout << c[10];
+    using policy_type = sjtu::random_policy<std::string>;
+    using map_t = sjtu::linked_hashmap<std::string, policy_type::meta>;
+    map_t map;
+    policy_type policy(7);
+    bool ok = true;
+    for (int i = 0; i < 1000; i++) {
+        // long keys, so every one owns a heap block
+        auto res = map.insert(map_t::value_type(std::string(32, 'a') + std::to_string(i), policy_type::meta()));
+        policy.on_insert(map, res.first);
+        if (map.size() > 100) {
+            map_t::iterator victim = policy.choose_victim(map);
+            ok &= victim != map.end() && victim != --map.end();
+            policy.on_remove(map, victim);
+            map.remove(victim);
+        }
+    }
+    policy_type copy(policy);
+    ok &= map.size() == 100 && policy.count == 100 && copy.count == 100;
+    for (size_t i = 0; i < policy.count; i++)
+        ok &= map.find(copy.keys[i]) != map.end() && map.find(policy.keys[i])->second.position == i;
+    result(ok);
+}
+
+void arc_negative_tester()
+{
+    std::cout << c[11];
+    sjtu::arc cache(-3);
+    bool ok = cache.size == 0;
+    for (int i = 0; i < 10; i++) {
+        cache.save(value_type(Integer(i), Matrix<int>(1, 1, i)));
+        ok &= cache.get(i) == nullptr;
+    }
+    ok &= cache.t1.size() + cache.t2.size() + cache.b1.size() + cache.b2.size() == 0;
+    result(ok);
+}
+
+void lru_negative_tester()
+{
+    std::cout << c[12];
+    sjtu::lru cache(-3);
+    bool ok = cache.size == 0;
+    for (int i = 0; i < 10; i++) {
+        cache.save(value_type(Integer(i), Matrix<int>(1, 1, i)));
+        ok &= cache.get(i) == nullptr;
+    }
+    ok &= cache.map.size() == 0 && cache.weight == 0;
+    result(ok);
+}
+
+int main()
+{
+#ifdef _OUTPUT_
+    freopen("12.out", "w", stdout);
+#endif
+    fifo_tester();
+    clock_tester();
+    random_tester();
+    arc_scan_tester();
+    arc_bound_tester();
+    byte_tester();
+    clock_referenced_tester();
+    random_uniform_tester();
+    random_key_tester();
+    arc_negative_tester();
+    lru_negative_tester();
+    std::cout << c[13] << std::endl;
+}
@@ -0,0 +1,183 @@
+#include "src.hpp"
+#if defined(_UNORDERED_MAP_) || (defined(_LIST_)) || (defined(_MAP_)) || (defined(_SET_)) || (defined(_UNORDERED_SET_)) || (defined(_GLIBCXX_MAP)) || (defined(_GLIBCXX_UNORDERED_MAP))
+BOOM :)
+#endif
+#include <iostream>
+#include <random>
+#include <string>
+
+std::string c[]={
+    "   pass!",
+    "   error.",
+    "test1: sketch counts and ages",
+    "test2: tinylfu keeps the hot keys through a scan",
+    "test3: tinylfu bounds of window and main",
+    "test4: slru keeps the hot keys through a scan",
+    "test5: slru demotes from protect to probation",
+    "test6: slru bounds of probation and protect",
+    "test7: slru keeps a slot for probation",
+    "Congratulations. Your submission has passed all correctness tests. Good job! :)",
+};
+
+using value_type = sjtu::pair<Integer, Matrix<int>>;
+
+void result(bool ok)
+{
+    std::cout << (ok ? c[0] : c[1]) << std::endl;
+}
+
+void sketch_tester()
+{
+    std::cout << c[2];
+    sjtu::frequency_sketch sketch(64);
+    size_t hot = sjtu::hash_mix(1), cold = sjtu::hash_mix(2);
+    bool ok = true;
+    for (int i = 0; i < 20; i++)
+        sketch.increment(hot);
+    sketch.increment(cold);
+    ok &= sketch.estimate(hot) == 15 && sketch.estimate(cold) >= 1;
+    sketch.age();
+    ok &= sketch.estimate(hot) == 7 && sketch.estimate(cold) == 0;
+    for (size_t i = 0; i < 640; i++)
+        sketch.increment(sjtu::hash_mix(i + 100));
+    ok &= sketch.estimate(hot) < 7;
+    result(ok);
+}
+
+/**
+ * every round gets hot keys, then scans twice the size of new keys once
+ * return how many gets of the hot keys hit
+ */
+template <class Cache>
+int scan_hits(int n)
+{
+    Cache cache(n);
+    std::mt19937 rng(2024);
+    int hits = 0, scan = n;
+    for (int round = 0; round < 10; round++) {
+        for (int i = 0; i < 10 * n; i++) {
+            int key = rng() % (n / 2);
+            if (cache.get(key) != nullptr)
+                hits++;
+            else
+                cache.save(value_type(Integer(key), Matrix<int>(1, 1, key)));
+        }
+        for (int i = 0; i < 2 * n; i++, scan++) {
+            if (cache.get(scan) == nullptr)
+                cache.save(value_type(Integer(scan), Matrix<int>()));
+        }
+    }
+    return hits;
+}
+
+void scan_tester()
+{
+    std::cout << c[3];
+    int tinylfu_hits = scan_hits<sjtu::tinylfu>(200);
+    int lru_hits = scan_hits<sjtu::lru>(200);
+    result(tinylfu_hits > lru_hits && tinylfu_hits > 20000 - 200);
+}
+
+void bound_tester()
+{
+    std::cout << c[4];
+    std::mt19937 rng(7);
+    bool ok = true;
+    for (size_t n : {0, 1, 2, 5, 17, 300}) {
+        sjtu::tinylfu cache(n);
+        for (int i = 0; i < 20000; i++) {
+            int key = rng() % 4 == 0 ? rng() % (n * 8 + 1) : rng() % (n + 3);
+            Matrix<int>* res = cache.get(key);
+            if (res == nullptr)
+                cache.save(value_type(Integer(key), Matrix<int>(1, 1, key)));
+            else
+                ok &= (*res)[0][0] == key;
+            ok &= cache.window.size() <= cache.window_size;
+            ok &= cache.window.size() + cache.main.size() <= n;
+        }
+    }
+    result(ok);
+}
+
+void slru_scan_tester()
+{
+    std::cout << c[5];
+    int slru_hits = scan_hits<sjtu::slru>(200);
+    int lru_hits = scan_hits<sjtu::lru>(200);
+    result(slru_hits > lru_hits && slru_hits > 20000 - 200);
+}
+
+void slru_demote_tester()
+{
+    std::cout << c[6];
+    sjtu::slru cache(4, 0.5);
+    for (int i = 0; i < 4; i++)
+        cache.save(value_type(Integer(i), Matrix<int>(1, 1, i)));
+    bool ok = true;
+    for (int i = 0; i < 3; i++)
+        ok &= cache.get(i) != nullptr;
+    ok &= cache.protect.size() == 2 && cache.probation.size() == 2;
+    ok &= cache.probation.find(Integer(0)) != cache.probation.end();
+    cache.save(value_type(Integer(4), Matrix<int>(1, 1, 4)));
+    ok &= cache.get(3) == nullptr && cache.get(0) != nullptr;
+    result(ok);
+}
+
+void slru_bound_tester()
+{
+    std::cout << c[7];
+    std::mt19937 rng(7);
+    bool ok = true;
+    for (double ratio : {0.0, 0.5, 0.8, 1.0}) {
+        for (size_t n : {0, 1, 2, 5, 17, 300}) {
+            sjtu::slru cache(n, ratio);
+            for (int i = 0; i < 20000; i++) {
+                int key = rng() % 4 == 0 ? rng() % (n * 8 + 1) : rng() % (n + 3);
+                Matrix<int>* res = cache.get(key);
+                if (res == nullptr)
+                    cache.save(value_type(Integer(key), Matrix<int>(1, 1, key)));
+                else
+                    ok &= (*res)[0][0] == key;
+                ok &= cache.protect.size() <= cache.protect_size;
+                ok &= cache.probation.size() + cache.protect.size() <= n;
+            }
+        }
+    }
+    result(ok);
+}
+
+void slru_full_tester()
+{
+    std::cout << c[8];
+    sjtu::slru cache(4, 1.0);
+    bool ok = cache.protect_size == 3;
+    for (int i = 0; i < 4; i++) {
+        cache.save(value_type(Integer(i), Matrix<int>(1, 1, i)));
+        cache.get(i);
+    }
+    for (int i = 4; i < 8; i++) {
+        cache.save(value_type(Integer(i), Matrix<int>(1, 1, i)));
+        ok &= cache.get(i) != nullptr;
+    }
+    ok &= cache.probation.size() + cache.protect.size() == 4;
+    sjtu::slru single(1, 1.0);
+    single.save(value_type(Integer(1), Matrix<int>(1, 1, 1)));
+    single.save(value_type(Integer(2), Matrix<int>(1, 1, 2)));
+    ok &= single.protect_size == 0 && single.get(2) != nullptr && single.get(1) == nullptr;
+    result(ok);
+}
+
+int main()
+{
+#ifdef _OUTPUT_
+    freopen("13.out", "w", stdout);
+#endif
+    sketch_tester();
+    scan_tester();
+    bound_tester();
+    slru_scan_tester();
+    slru_demote_tester();
+    slru_bound_tester();
+    slru_full_tester();
+    std::cout << c[9] << std::endl;
+}
@@ -0,0 +1,215 @@
+#include "src.hpp"
+#if defined(_UNORDERED_MAP_) || (defined(_LIST_)) || (defined(_MAP_)) || (defined(_SET_)) || (defined(_UNORDERED_SET_)) || (defined(_GLIBCXX_MAP)) || (defined(_GLIBCXX_UNORDERED_MAP))
+BOOM :)
+#endif
+#include <iostream>
+#include <random>
+#include <string>
+
+std::string c[]={
+    "   pass!",
+    "   error.",
+    "test1: expire after write",
+    "test2: expire after access",
+    "test3: a ttl of the save",
+    "test4: expiry against the deadlines",
+    "test5: a copy keeps expiring",
+    "test6: a long idle is jumped over",
+    "test7: the timers follow shrink_to_fit",
+    "Congratulations. Your submission has passed all correctness tests. Good job! :)",
+};
+
+using value_type = sjtu::pair<Integer, Matrix<int>>;
+
+void result(bool ok)
+{
+    std::cout << (ok ? c[0] : c[1]) << std::endl;
+}
+
+/**
+ * a clock turned by hand
+ */
+unsigned long long now = 0;
+class manual_clock {
+public:
+    unsigned long long operator()() const
+    {
+        return now;
+    }
+};
+
+using write_cache = sjtu::expiring_lru<sjtu::expire_after_write<manual_clock>>;
+using access_cache = sjtu::expiring_lru<sjtu::expire_after_access<manual_clock>>;
+
+void write_tester()
+{
+    std::cout << c[2];
+    now = 1000;
+    write_cache cache(10, sjtu::expire_after_write<manual_clock>(100));
+    cache.save(value_type(Integer(1), Matrix<int>(1, 1, 1)));
+    bool ok = true;
+    now = 1050;
+    ok &= cache.get(1) != nullptr;
+    now = 1099;
+    ok &= cache.get(1) != nullptr;
+    now = 1100;
+    ok &= cache.get(1) == nullptr && cache.map.size() == 0 && cache.expiry.wheel.count == 0;
+    result(ok);
+}
+
+void access_tester()
+{
+    std::cout << c[3];
+    now = 0;
+    access_cache cache(10, sjtu::expire_after_access<manual_clock>(100));
+    cache.save(value_type(Integer(1), Matrix<int>(1, 1, 1)));
+    cache.save(value_type(Integer(2), Matrix<int>(1, 1, 2)));
+    bool ok = true;
+    for (now = 50; now <= 1000; now += 50)
+        ok &= cache.get(1) != nullptr;
+    ok &= cache.get(2) == nullptr && cache.map.size() == 1;
+    result(ok);
+}
+
+void ttl_tester()
+{
+    std::cout << c[4];
+    now = 0;
+    write_cache cache(10, sjtu::expire_after_write<manual_clock>(100));
+    cache.save(value_type(Integer(1), Matrix<int>(1, 1, 1)), 10);
+    cache.save(value_type(Integer(2), Matrix<int>(1, 1, 2)));
+    cache.save(value_type(Integer(3), Matrix<int>(1, 1, 3)), 100000000);
+    bool ok = true;
+    now = 10;
+    ok &= cache.get(1) == nullptr && cache.get(2) != nullptr;
+    now = 100;
+    ok &= cache.get(2) == nullptr && cache.get(3) != nullptr;
+    now = 99999999;
+    ok &= cache.get(3) != nullptr;
+    now = 100000000;
+    ok &= cache.get(3) == nullptr && cache.map.size() == 0;
+    result(ok);
+}
+
+void deadline_tester()
+{
+    std::cout << c[5];
+    const int keys = 200;
+    std::mt19937 rng(5);
+    now = rng();
+    access_cache cache(keys, sjtu::expire_after_access<manual_clock>(300));
+    unsigned long long deadline[keys], ttl[keys];
+    bool live[keys] = {};
+    bool ok = true;
+    for (int i = 0; i < 200000; i++) {
+        int r = rng() % 1000;
+        if (r < 5)
+            now += rng() % (1 << 26);
+        else if (r < 300)
+            now += rng() % 8;
+        for (int k = 0; k < keys; k++)
+            live[k] &= deadline[k] > now;
+        int key = rng() % keys;
+        if (rng() % 2 == 0) {
+            ok &= (cache.get(key) != nullptr) == live[key];
+            if (live[key])
+                deadline[key] = now + ttl[key];
+        } else {
+            ttl[key] = rng() % 4 == 0 ? rng() % (1 << 22) : 300;
+            if (ttl[key] == 300)
+                cache.save(value_type(Integer(key), Matrix<int>(1, 1, key)));
+            else
+                cache.save(value_type(Integer(key), Matrix<int>(1, 1, key)), ttl[key]);
+            deadline[key] = now + (ttl[key] > 0 ? ttl[key] : 1);
+            live[key] = true;
+        }
+        size_t total = 0;
+        for (int k = 0; k < keys; k++)
+            total += live[k];
+        ok &= cache.map.size() == total && cache.expiry.wheel.count == total;
+    }
+    result(ok);
+}
+
+void copy_tester()
+{
+    std::cout << c[6];
+    now = 0;
+    write_cache cache(10, sjtu::expire_after_write<manual_clock>(100));
+    for (int i = 0; i < 10; i++) {
+        now = i * 10;
+        cache.save(value_type(Integer(i), Matrix<int>(1, 1, i)));
+    }
+    write_cache copy(cache);
+    write_cache moved(std::move(cache));
+    bool ok = copy.expiry.wheel.count == 10 && moved.expiry.wheel.count == 10;
+    now = 145;
+    ok &= copy.map.size() == 10 && copy.get(4) == nullptr && copy.get(5) != nullptr && copy.map.size() == 5;
+    ok &= moved.get(4) == nullptr && moved.get(5) != nullptr && moved.map.size() == 5;
+    cache = copy;
+    now = 1000;
+    cache.save(value_type(Integer(20), Matrix<int>(1, 1, 20)));
+    ok &= cache.map.size() == 1 && cache.get(9) == nullptr;
+    result(ok);
+}
+
+/**
+ * a wheel walking every tick would never finish this
+ */
+void idle_tester()
+{
+    std::cout << c[7];
+    now = 0;
+    write_cache cache(10, sjtu::expire_after_write<manual_clock>(1ULL << 40));
+    cache.save(value_type(Integer(1), Matrix<int>(1, 1, 1)));
+    cache.save(value_type(Integer(2), Matrix<int>(1, 1, 2)), 1ULL << 30);
+    bool ok = true;
+    now = (1ULL << 30) - 1;
+    ok &= cache.get(2) != nullptr;
+    now = 1ULL << 30;
+    ok &= cache.get(2) == nullptr && cache.get(1) != nullptr;
+    now = (1ULL << 40) - 1;
+    ok &= cache.get(1) != nullptr;
+    now = 1ULL << 40;
+    ok &= cache.get(1) == nullptr && cache.expiry.wheel.count == 0;
+    result(ok);
+}
+
+void relocate_tester()
+{
+    std::cout << c[8];
+    now = 0;
+    write_cache cache(100, sjtu::expire_after_write<manual_clock>(100));
+    for (int i = 0; i < 50; i++) {
+        now = i;
+        cache.save(value_type(Integer(i), Matrix<int>(1, 1, i)));
+    }
+    for (int i = 0; i < 40; i++)
+        cache.erase(i);
+    // the entries move into new nodes, their timers take the old places
+    cache.map.shrink_to_fit();
+    bool ok = cache.expiry.wheel.count == 10 && cache.map.size() == 10;
+    now = 144;
+    ok &= cache.get(45) != nullptr && cache.get(44) == nullptr && cache.map.size() == 5;
+    now = 149;
+    ok &= cache.get(49) == nullptr && cache.map.size() == 0 && cache.expiry.wheel.count == 0;
+    cache.save(value_type(Integer(1), Matrix<int>(1, 1, 1)));
+    now = 249;
+    ok &= cache.get(1) == nullptr && cache.map.size() == 0;
+    result(ok);
+}
+
+int main()
+{
+#ifdef _OUTPUT_
+    freopen("14.out", "w", stdout);
+#endif
+    write_tester();
+    access_tester();
+    ttl_tester();
+    deadline_tester();
+    copy_tester();
+    idle_tester();
+    relocate_tester();
+    std::cout << c[9] << std::endl;
+}
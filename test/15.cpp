@@ -0,0 +1,177 @@
+#include "src.hpp"
+#if defined(_UNORDERED_MAP_) || (defined(_LIST_)) || (defined(_MAP_)) || (defined(_SET_)) || (defined(_UNORDERED_SET_)) || (defined(_GLIBCXX_MAP)) || (defined(_GLIBCXX_UNORDERED_MAP))
+BOOM :)
+#endif
+#include <iostream>
+#include <string>
+
+std::string c[]={
+    "   pass!",
+    "   error.",
+    "test1: listener gets every cause",
+    "test2: write-back coalesces the saves",
+    "test3: write-back flushes by batch",
+    "test4: sync and destruction flush the dirty entries",
+    "test5: a moved-from write-back is usable again",
+    "Congratulations. Your submission has passed all correctness tests. Good job! :)",
+};
+
+using value_type = sjtu::pair<Integer, Matrix<int>>;
+
+void result(bool ok)
+{
+    std::cout << (ok ? c[0] : c[1]) << std::endl;
+}
+
+unsigned long long now = 0;
+class manual_clock {
+public:
+    unsigned long long operator()() const
+    {
+        return now;
+    }
+};
+
+/**
+ * the removals seen by the listener: key, first element of the value, cause
+ */
+int removed[100][3], removals = 0;
+class recorder {
+public:
+    void operator()(const Integer& key, Matrix<int>& value, sjtu::removal_cause cause)
+    {
+        removed[removals][0] = key.val;
+        removed[removals][1] = value[0][0];
+        removed[removals][2] = int(cause);
+        removals++;
+    }
+};
+
+/**
+ * the pairs flushed: key and first element of the value, and the batches
+ */
+int flushed[1000][2], flushes = 0, batches = 0;
+class store {
+public:
+    void operator()(sjtu::pair<const Integer, Matrix<int>>* pairs, size_t n)
+    {
+        for (size_t i = 0; i < n; i++, flushes++) {
+            flushed[flushes][0] = pairs[i].first.val;
+            flushed[flushes][1] = pairs[i].second[0][0];
+        }
+        batches++;
+    }
+};
+
+bool record(int i, int key, int value, sjtu::removal_cause cause)
+{
+    return removed[i][0] == key && removed[i][1] == value && removed[i][2] == int(cause);
+}
+
+void listener_tester()
+{
+    std::cout << c[2];
+    using cache_type = sjtu::basic_lru<sjtu::lru_policy, sjtu::count_weigher, sjtu::expire_after_write<manual_clock>, sjtu::removal_listener<recorder>>;
+    now = 0;
+    cache_type cache(2, sjtu::lru_policy(), sjtu::count_weigher(), sjtu::expire_after_write<manual_clock>(100));
+    cache.save(value_type(Integer(1), Matrix<int>(1, 1, 10)));
+    cache.save(value_type(Integer(1), Matrix<int>(1, 1, 11)));
+    cache.save(value_type(Integer(2), Matrix<int>(1, 1, 20)));
+    cache.save(value_type(Integer(3), Matrix<int>(1, 1, 30)));
+    bool ok = cache.erase(2) && !cache.erase(2);
+    now = 100;
+    ok &= cache.get(3) == nullptr;
+    ok &= removals == 4;
+    ok &= record(0, 1, 10, sjtu::removal_cause::replaced);
+    ok &= record(1, 1, 11, sjtu::removal_cause::size);
+    ok &= record(2, 2, 20, sjtu::removal_cause::erased);
+    ok &= record(3, 3, 30, sjtu::removal_cause::expired);
+    result(ok);
+}
+
+void coalesce_tester()
+{
+    std::cout << c[3];
+    flushes = batches = 0;
+    sjtu::write_back_lru<store> cache(2);
+    for (int i = 0; i < 10; i++)
+        cache.save(value_type(Integer(1), Matrix<int>(1, 1, i)));
+    cache.save(value_type(Integer(2), Matrix<int>(1, 1, 20)));
+    cache.save(value_type(Integer(3), Matrix<int>(1, 1, 30)));
+    bool ok = flushes == 0;
+    cache.sync();
+    ok &= batches == 1 && flushes == 3;
+    ok &= flushed[0][0] == 1 && flushed[0][1] == 9;
+    cache.sync();
+    ok &= batches == 1;
+    cache.get(2);
+    cache.save(value_type(Integer(4), Matrix<int>(1, 1, 40)));
+    cache.sync();
+    ok &= batches == 2 && flushes == 4 && flushed[3][0] == 4;
+    result(ok);
+}
+
+void batch_tester()
+{
+    std::cout << c[4];
+    flushes = batches = 0;
+    sjtu::write_back_lru<store> cache(1);
+    for (int i = 0; i < 200; i++)
+        cache.save(value_type(Integer(i), Matrix<int>(1, 1, i)));
+    bool ok = batches == 3 && flushes == 192;
+    for (int i = 0; i < 192; i++)
+        ok &= flushed[i][0] == i && flushed[i][1] == i;
+    result(ok);
+}
+
+void sync_tester()
+{
+    std::cout << c[5];
+    flushes = batches = 0;
+    {
+        sjtu::write_back_lru<store> cache(5);
+        for (int i = 0; i < 8; i++)
+            cache.save(value_type(Integer(i), Matrix<int>(1, 1, i)));
+        sjtu::write_back_lru<store> other(5);
+        other.save(value_type(Integer(100), Matrix<int>(1, 1, 100)));
+        other = std::move(cache);
+    }
+    bool ok = flushes == 9;
+    int seen = 0;
+    for (int i = 0; i < flushes; i++)
+        seen += flushed[i][0] == 100 || flushed[i][1] == flushed[i][0];
+    ok &= seen == 9;
+    result(ok);
+}
+
+void reuse_tester()
+{
+    std::cout << c[6];
+    flushes = batches = 0;
+    sjtu::write_back_lru<store> cache(1);
+    cache.save(value_type(Integer(1), Matrix<int>(1, 1, 1)));
+    sjtu::write_back_lru<store> other(std::move(cache));
+    cache = sjtu::write_back_lru<store>(1);
+    sjtu::write_back_lru<store> third(std::move(cache));
+    for (int i = 10; i < 13; i++)
+        cache.save(value_type(Integer(i), Matrix<int>(1, 1, i)));
+    bool ok = flushes == 0;
+    cache.sync();
+    ok &= flushes == 3 && flushed[0][0] == 10 && flushed[2][0] == 12;
+    other.sync();
+    ok &= flushes == 4 && flushed[3][0] == 1;
+    result(ok);
+}
+
+int main()
+{
+#ifdef _OUTPUT_
+    freopen("15.out", "w", stdout);
+#endif
+    listener_tester();
+    coalesce_tester();
+    batch_tester();
+    sync_tester();
+    reuse_tester();
+    std::cout << c[7] << std::endl;
+}
@@ -0,0 +1,180 @@
+#include "src.hpp"
+#if defined(_UNORDERED_MAP_) || (defined(_LIST_)) || (defined(_MAP_)) || (defined(_SET_)) || (defined(_UNORDERED_SET_)) || (defined(_GLIBCXX_MAP)) || (defined(_GLIBCXX_UNORDERED_MAP))
+BOOM :)
+#endif
+#include <iostream>
+#include <string>
+
+std::string c[]={
+    "   pass!",
+    "   error.",
+    "test1: clear keeps the table",
+    "test2: shrink_to_fit gives the memory back",
+    "test3: min_load_factor",
+    "test4: remove shrinks down to the reserved buckets",
+    "test5: remove shrinks a few buckets at a time",
+    "Congratulations. Your submission has passed all correctness tests. Good job! :)",
+};
+
+using map_type = sjtu::hashmap<int, int>;
+
+void result(bool ok)
+{
+    std::cout << (ok ? c[0] : c[1]) << std::endl;
+}
+
+/**
+ * whether the keys [first, last) are found with value key * 2
+ */
+bool holds(const map_type& map, int first, int last)
+{
+    bool ok = true;
+    for (int i = first; i < last; i++) {
+        map_type::iterator it = map.find(i);
+        ok &= it != map.end() && it->second == i * 2;
+    }
+    return ok;
+}
+
+void fill(map_type& map, int first, int last)
+{
+    for (int i = first; i < last; i++)
+        map.insert(map_type::value_type(i, i * 2));
+}
+
+void clear_tester()
+{
+    std::cout << c[2];
+    map_type map;
+    fill(map, 0, 1000);
+    size_t buckets = map.bucket_count();
+    map.clear();
+    bool ok = map.empty() && map.bucket_count() == buckets && map.find(1) == map.end();
+    fill(map, 1000, 2000);
+    ok &= map.bucket_count() == buckets && holds(map, 1000, 2000) && map.find(1) == map.end();
+    map.clear();
+    map.clear();
+    ok &= map.empty();
+    result(ok);
+}
+
+void shrink_tester()
+{
+    std::cout << c[3];
+    map_type map;
+    map.min_load_factor(0);
+    fill(map, 0, 10000);
+    size_t buckets = map.bucket_count();
+    for (int i = 100; i < 10000; i++)
+        map.remove(i);
+    bool ok = map.bucket_count() == buckets;
+    map.shrink_to_fit();
+    ok &= map.bucket_count() <= 256 && map.old_table == nullptr && holds(map, 0, 100);
+    ok &= map.min_load_factor() == 0 && map.elements == 100;
+    fill(map, 100, 10000);
+    ok &= holds(map, 0, 10000);
+    map_type empty;
+    empty.shrink_to_fit();
+    fill(empty, 0, 10);
+    ok &= holds(empty, 0, 10);
+    result(ok);
+}
+
+void min_load_tester()
+{
+    std::cout << c[4];
+    map_type map;
+    bool ok = map.min_load_factor() == 0.125f;
+    try {
+        map.min_load_factor(0.6f);
+        ok = false;
+    } catch (sjtu::runtime_error&) {
+    }
+    try {
+        map.min_load_factor(-1);
+        ok = false;
+    } catch (sjtu::runtime_error&) {
+    }
+    map.max_load_factor(0.2f);
+    ok &= map.min_load_factor() == 0.2f / 8;
+    map.max_load_factor(1.0f);
+    map.min_load_factor(0.25f);
+    fill(map, 0, 4096);
+    size_t buckets = map.bucket_count();
+    for (int i = 0; i < 3100; i++)
+        map.remove(i);
+    ok &= map.bucket_count() < buckets && map.load_factor() >= 0.25f && holds(map, 3100, 4096);
+    result(ok);
+}
+
+void contract_tester()
+{
+    std::cout << c[5];
+    map_type map;
+    fill(map, 0, 100000);
+    for (int i = 0; i < 100000; i++)
+        map.remove(i);
+    bool ok = map.empty() && map.old_table == nullptr && map.bucket_count() == map_type::min_buckets;
+    map_type reserved;
+    reserved.reserve(50000);
+    size_t buckets = reserved.bucket_count();
+    for (int round = 0; round < 3; round++) {
+        fill(reserved, 0, 100000);
+        for (int i = 0; i < 100000; i++)
+            reserved.remove(i);
+        ok &= reserved.bucket_count() == buckets && reserved.old_table == nullptr;
+    }
+    fill(reserved, 0, 50000);
+    ok &= reserved.bucket_count() == buckets && holds(reserved, 0, 50000);
+    result(ok);
+}
+
+void incremental_shrink_tester()
+{
+    std::cout << c[6];
+    map_type map;
+    fill(map, 0, 4096);
+    bool ok = map.bucket_count() == 4096 && map.old_table == nullptr;
+    for (int i = 0; i < 3585; i++)
+        map.remove(i);
+    // below low the buckets are halved, and the old ones are moved later
+    ok &= map.bucket_count() == 2048 && map.old_table != nullptr && map.migrated == 0;
+    ok &= holds(map, 3585, 4096) && map.step == 17;
+    int removed = 3585;
+    while (map.old_table != nullptr)
+        map.remove(removed++);
+    ok &= removed - 3585 == 241 && map.elements >= map.low && holds(map, removed, 4096);
+    // min_load_factor stays a quarter of max_load_factor at most
+    try {
+        map.min_load_factor(0.3f);
+        ok = false;
+    } catch (sjtu::runtime_error&) {
+    }
+    map.min_load_factor(0.25f);
+    // inserting and removing at the limit does not expand and shrink in turn
+    map_type edge;
+    edge.min_load_factor(0.25f);
+    fill(edge, 0, 1024);
+    size_t resizes = 0, buckets = edge.bucket_count();
+    for (int i = 0; i < 1000; i++) {
+        fill(edge, 1024, 1025);
+        edge.remove(1024);
+        resizes += edge.bucket_count() != buckets;
+        buckets = edge.bucket_count();
+    }
+    ok &= resizes <= 1 && holds(edge, 0, 1024);
+    result(ok);
+}
+
+int main()
+{
+#ifdef _OUTPUT_
+    freopen("16.out", "w", stdout);
+#endif
+    clear_tester();
+    shrink_tester();
+    min_load_tester();
+    contract_tester();
+    incremental_shrink_tester();
+    std::cout << c[7] << std::endl;
+}
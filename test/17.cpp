@@ -0,0 +1,119 @@
+#include "src.hpp"
+#if defined(_UNORDERED_MAP_) || (defined(_LIST_)) || (defined(_MAP_)) || (defined(_SET_)) || (defined(_UNORDERED_SET_)) || (defined(_GLIBCXX_MAP)) || (defined(_GLIBCXX_UNORDERED_MAP))
+BOOM :)
+#endif
+#include <iostream>
+#include <string>
+
+std::string c[]={
+    "   pass!",
+    "   error.",
+    "test1: lookups by int",
+    "Congratulations. Your submission has passed all correctness tests. Good job! :)",
+};
+
+using lmap = sjtu::linked_hashmap<Integer, int, Hash, Equal>;
+
+void result(bool ok)
+{
+    std::cout << (ok ? c[0] : c[1]) << std::endl;
+}
+
+/**
+ * transparent Hash and Equal remembering the most Integers alive
+ * while they see an int, a temporary key would show up there
+ */
+int peak = 0;
+class peak_hash {
+public:
+    using is_transparent = void;
+    unsigned int operator()(const Integer& key) const
+    {
+        return Hash()(key);
+    }
+    unsigned int operator()(int key) const
+    {
+        peak = peak > Integer::counter ? peak : Integer::counter;
+        return Hash()(key);
+    }
+};
+class peak_equal {
+public:
+    using is_transparent = void;
+    bool operator()(const Integer& lhs, const Integer& rhs) const
+    {
+        return lhs.val == rhs.val;
+    }
+    bool operator()(const Integer& lhs, int rhs) const
+    {
+        peak = peak > Integer::counter ? peak : Integer::counter;
+        return lhs.val == rhs;
+    }
+};
+/**
+ * Hash and Equal of Integer only
+ */
+class plain_hash {
+public:
+    unsigned int operator()(const Integer& key) const
+    {
+        return key.val;
+    }
+};
+class plain_equal {
+public:
+    bool operator()(const Integer& lhs, const Integer& rhs) const
+    {
+        return lhs.val == rhs.val;
+    }
+};
+
+template <class Map, class K>
+constexpr bool finds_by = requires(Map map, K key) { map.find(key, size_t(0)); };
+template <class Map, class K>
+constexpr bool removes_by = requires(Map map, K key) { map.remove(key, size_t(0)); };
+static_assert(finds_by<sjtu::hashmap<Integer, int, Hash, Equal>, int>);
+static_assert(removes_by<sjtu::hashmap<Integer, int, Hash, Equal>, int>);
+static_assert(finds_by<lmap, int>);
+static_assert(!finds_by<sjtu::hashmap<Integer, int, plain_hash, plain_equal>, int>);
+static_assert(!removes_by<sjtu::hashmap<Integer, int, plain_hash, plain_equal>, int>);
+static_assert(!finds_by<sjtu::linked_hashmap<Integer, int, plain_hash, plain_equal>, int>);
+static_assert(finds_by<sjtu::linked_hashmap<Integer, int, plain_hash, plain_equal>, Integer>);
+static_assert(!finds_by<sjtu::hashmap<int, int>, long>);
+
+void transparent_tester()
+{
+    std::cout << c[2];
+    bool ok = true;
+    {
+        sjtu::linked_hashmap<Integer, int, peak_hash, peak_equal> map;
+        for (int i = 0; i < 100; i++)
+            map.insert(sjtu::pair<const Integer, int>(Integer(i), i));
+        int alive = Integer::counter;
+        peak = 0;
+        for (int i = 0; i < 200; i++) {
+            ok &= (map.find(i) != map.end()) == (i < 100);
+            ok &= map.count(i) == size_t(i < 100);
+        }
+        ok &= map.at(7) == 7 && map.touch(7) != map.end();
+        ok &= map.find(99, map.hash(99)) != map.end();
+        ok &= peak == alive;
+    }
+    sjtu::hashmap<Integer, int, Hash, Equal> map;
+    for (int i = 0; i < 100; i++)
+        map.insert(sjtu::pair<const Integer, int>(Integer(i), i));
+    for (int i = 0; i < 100; i += 2)
+        ok &= map.remove(i);
+    ok &= !map.remove(0) && map.find(1)->second == 1 && map.find(2) == map.end();
+    ok &= map.remove(Integer(1)) && map.elements == 49;
+    result(ok);
+}
+
+int main()
+{
+#ifdef _OUTPUT_
+    freopen("17.out", "w", stdout);
+#endif
+    transparent_tester();
+    std::cout << c[3] << std::endl;
+}
@@ -0,0 +1,86 @@
+#include "src.hpp"
+#if defined(_UNORDERED_MAP_) || (defined(_LIST_)) || (defined(_MAP_)) || (defined(_SET_)) || (defined(_UNORDERED_SET_)) || (defined(_GLIBCXX_MAP)) || (defined(_GLIBCXX_UNORDERED_MAP))
+BOOM :)
+#endif
+#include <iostream>
+#include <string>
+
+std::string c[]={
+    "   pass!",
+    "   error.",
+    "test1: expand moves the buckets a few at a time",
+    "Congratulations. Your submission has passed all correctness tests. Good job! :)",
+};
+
+using map_type = sjtu::hashmap<int, int>;
+
+void result(bool ok)
+{
+    std::cout << (ok ? c[0] : c[1]) << std::endl;
+}
+
+/**
+ * whether the keys [first, last) are found with value key * 2
+ */
+bool holds(const map_type& map, int first, int last)
+{
+    bool ok = true;
+    for (int i = first; i < last; i++) {
+        map_type::iterator it = map.find(i);
+        ok &= it != map.end() && it->second == i * 2;
+    }
+    return ok;
+}
+
+void fill(map_type& map, int first, int last)
+{
+    for (int i = first; i < last; i++)
+        map.insert(map_type::value_type(i, i * 2));
+}
+
+void migrate_tester()
+{
+    std::cout << c[2];
+    map_type map;
+    fill(map, 0, 513);
+    bool ok = map.bucket_count() == 1024 && map.old_table != nullptr;
+    ok &= map.old_mask == 511 && map.migrated == 0 && holds(map, 0, 513);
+    // 385 removes could take the map below low, so 512 buckets need 2 a time
+    ok &= map.step == 2;
+    // every insert or remove moves two old buckets, lookups see both tables
+    fill(map, 513, 613);
+    ok &= map.migrated == 200 && holds(map, 0, 613);
+    for (int i = 0; i < 50; i++)
+        ok &= map.remove(i);
+    ok &= !map.remove(0) && map.migrated == 302;
+    ok &= map.find(0) == map.end() && holds(map, 50, 613);
+    fill(map, 613, 717);
+    ok &= map.old_table != nullptr && map.migrated == 510;
+    fill(map, 717, 718);
+    ok &= map.old_table == nullptr && map.bucket_count() == 1024 && holds(map, 50, 718);
+    ok &= map.elements == 668;
+    // rehash_step is the least step
+    map_type lazy;
+    lazy.rehash_step = 8;
+    fill(lazy, 0, 513);
+    ok &= lazy.step == 8 && lazy.old_table != nullptr;
+    fill(lazy, 513, 576);
+    ok &= lazy.old_table != nullptr && lazy.migrated == 504;
+    fill(lazy, 576, 577);
+    ok &= lazy.old_table == nullptr && holds(lazy, 0, 577);
+    // a rehash_step of 0 moves everything in expand
+    map_type eager;
+    eager.rehash_step = 0;
+    fill(eager, 0, 513);
+    ok &= eager.bucket_count() == 1024 && eager.old_table == nullptr && holds(eager, 0, 513);
+    result(ok);
+}
+
+int main()
+{
+#ifdef _OUTPUT_
+    freopen("18.out", "w", stdout);
+#endif
+    migrate_tester();
+    std::cout << c[3] << std::endl;
+}
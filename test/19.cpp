@@ -0,0 +1,68 @@
+#include "src.hpp"
+#if defined(_UNORDERED_MAP_) || (defined(_LIST_)) || (defined(_MAP_)) || (defined(_SET_)) || (defined(_UNORDERED_SET_)) || (defined(_GLIBCXX_MAP)) || (defined(_GLIBCXX_UNORDERED_MAP))
+BOOM :)
+#endif
+#include <iostream>
+#include <string>
+
+std::string c[]={
+    "   pass!",
+    "   error.",
+    "test1: the nodes keep the hash of their key",
+    "Congratulations. Your submission has passed all correctness tests. Good job! :)",
+};
+
+void result(bool ok)
+{
+    std::cout << (ok ? c[0] : c[1]) << std::endl;
+}
+
+/**
+ * Hash and Equal counting their calls
+ */
+int hash_calls = 0, equal_calls = 0;
+class counting_hash {
+public:
+    size_t operator()(int key) const
+    {
+        hash_calls++;
+        return std::hash<int>()(key);
+    }
+};
+class counting_equal {
+public:
+    bool operator()(int lhs, int rhs) const
+    {
+        equal_calls++;
+        return lhs == rhs;
+    }
+};
+
+void cached_hash_tester()
+{
+    std::cout << c[2];
+    sjtu::hashmap<int, int, counting_hash, counting_equal> map;
+    // an insert hashes its key once, no expand or migration hashes again
+    for (int i = 0; i < 5000; i++)
+        map.insert(sjtu::pair<const int, int>(i, i));
+    map.rehash(100000);
+    map.shrink_to_fit();
+    bool ok = hash_calls == 5000;
+    for (int i = 0; i < 5000; i++)
+        ok &= map.find(i).p->hash == sjtu::hash_mix(std::hash<int>()(i));
+    // Equal only runs on a node whose hash is the same
+    hash_calls = equal_calls = 0;
+    for (int i = 0; i < 10000; i++)
+        map.find(i);
+    ok &= hash_calls == 10000 && equal_calls == 5000;
+    result(ok);
+}
+
+int main()
+{
+#ifdef _OUTPUT_
+    freopen("19.out", "w", stdout);
+#endif
+    cached_hash_tester();
+    std::cout << c[3] << std::endl;
+}
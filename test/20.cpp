@@ -0,0 +1,57 @@
+#include "src.hpp"
+#if defined(_UNORDERED_MAP_) || (defined(_LIST_)) || (defined(_MAP_)) || (defined(_SET_)) || (defined(_UNORDERED_SET_)) || (defined(_GLIBCXX_MAP)) || (defined(_GLIBCXX_UNORDERED_MAP))
+BOOM :)
+#endif
+#include <iostream>
+#include <string>
+
+std::string c[]={
+    "   pass!",
+    "   error.",
+    "test1: one node per entry",
+    "Congratulations. Your submission has passed all correctness tests. Good job! :)",
+};
+
+using lmap = sjtu::linked_hashmap<Integer, int, Hash, Equal>;
+
+void result(bool ok)
+{
+    std::cout << (ok ? c[0] : c[1]) << std::endl;
+}
+
+void node_tester()
+{
+    std::cout << c[2];
+    bool ok = true;
+    int alive = Integer::counter;
+    {
+        lmap map;
+        for (int i = 0; i < 1000; i++)
+            map.insert(lmap::value_type(Integer(i), i));
+        // one block and one Integer per entry, the key is not kept twice
+        ok &= map.map.pool.allocations == 1000 && map.map.pool.in_use == 1000;
+        ok &= Integer::counter == alive + 1000;
+        lmap::value_type* first = &*map.find(0);
+        for (int i = 1000; i < 20000; i++)
+            map.insert(lmap::value_type(Integer(i), i));
+        for (int i = 1000; i < 20000; i++)
+            map.remove(map.find(i));
+        // the list runs through the nodes of the hashmap, which never move
+        ok &= &*map.find(0) == first && &map.map.find(0).p->val == first;
+        int expect = 0;
+        for (lmap::iterator it = map.begin(); it != map.end(); ++it, ++expect)
+            ok &= it->first.val == expect && it->second == expect;
+        ok &= expect == 1000 && map.map.pool.in_use == 1000;
+    }
+    ok &= Integer::counter == alive;
+    result(ok);
+}
+
+int main()
+{
+#ifdef _OUTPUT_
+    freopen("20.out", "w", stdout);
+#endif
+    node_tester();
+    std::cout << c[3] << std::endl;
+}
@@ -0,0 +1,81 @@
+#include "src.hpp"
+#if defined(_UNORDERED_MAP_) || (defined(_LIST_)) || (defined(_MAP_)) || (defined(_SET_)) || (defined(_UNORDERED_SET_)) || (defined(_GLIBCXX_MAP)) || (defined(_GLIBCXX_UNORDERED_MAP))
+BOOM :)
+#endif
+#include <iostream>
+#include <string>
+
+std::string c[]={
+    "   pass!",
+    "   error.",
+    "test1: the nodes are recycled by the pool",
+    "Congratulations. Your submission has passed all correctness tests. Good job! :)",
+};
+
+using map_type = sjtu::hashmap<int, int>;
+
+void result(bool ok)
+{
+    std::cout << (ok ? c[0] : c[1]) << std::endl;
+}
+
+/**
+ * whether the keys [first, last) are found with value key * 2
+ */
+bool holds(const map_type& map, int first, int last)
+{
+    bool ok = true;
+    for (int i = first; i < last; i++) {
+        map_type::iterator it = map.find(i);
+        ok &= it != map.end() && it->second == i * 2;
+    }
+    return ok;
+}
+
+void fill(map_type& map, int first, int last)
+{
+    for (int i = first; i < last; i++)
+        map.insert(map_type::value_type(i, i * 2));
+}
+
+void pool_tester()
+{
+    std::cout << c[2];
+    sjtu::node_pool<long long> pool;
+    void* a = pool.allocate();
+    void* b = pool.allocate();
+    pool.deallocate(a);
+    bool ok = pool.allocate() == a && pool.in_use == 2 && pool.allocations == 3;
+    pool.deallocate(a);
+    pool.deallocate(b);
+    ok &= pool.in_use == 0 && pool.slab_count == 1;
+    // at a steady size, a list or a map never takes a new slab
+    sjtu::double_list<int> list;
+    for (int i = 0; i < 1000; i++)
+        list.insert_tail(i);
+    size_t slabs = list.pool.slab_count;
+    for (int i = 1000; i < 100000; i++) {
+        list.delete_head();
+        list.insert_tail(i);
+    }
+    ok &= list.pool.slab_count == slabs && list.pool.in_use == 1000;
+    ok &= list.pool.allocations == 100000 && *list.begin() == 99000;
+    map_type map;
+    fill(map, 0, 1000);
+    slabs = map.pool.slab_count;
+    for (int i = 1000; i < 100000; i++) {
+        map.remove(i - 1000);
+        fill(map, i, i + 1);
+    }
+    ok &= map.pool.slab_count == slabs && map.pool.in_use == 1000 && holds(map, 99000, 100000);
+    result(ok);
+}
+
+int main()
+{
+#ifdef _OUTPUT_
+    freopen("21.out", "w", stdout);
+#endif
+    pool_tester();
+    std::cout << c[3] << std::endl;
+}
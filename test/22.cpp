@@ -0,0 +1,109 @@
+#include "src.hpp"
+#if defined(_UNORDERED_MAP_) || (defined(_LIST_)) || (defined(_MAP_)) || (defined(_SET_)) || (defined(_UNORDERED_SET_)) || (defined(_GLIBCXX_MAP)) || (defined(_GLIBCXX_UNORDERED_MAP))
+BOOM :)
+#endif
+#include <initializer_list>
+#include <iostream>
+#include <string>
+
+std::string c[]={
+    "   pass!",
+    "   error.",
+    "test1: emplace, try_emplace and insert_or_assign",
+    "Congratulations. Your submission has passed all correctness tests. Good job! :)",
+};
+
+void result(bool ok)
+{
+    std::cout << (ok ? c[0] : c[1]) << std::endl;
+}
+
+/**
+ * a value counting how it is built
+ */
+int built = 0, copied = 0, moved = 0;
+class tracked {
+public:
+    int val;
+    tracked(int val)
+        : val(val)
+    {
+        built++;
+    }
+    tracked(int a, int b)
+        : val(a + b)
+    {
+        built++;
+    }
+    tracked(const tracked& other)
+        : val(other.val)
+    {
+        copied++;
+    }
+    tracked(tracked&& other) noexcept
+        : val(other.val)
+    {
+        other.val = -1;
+        moved++;
+    }
+    tracked& operator=(const tracked& other)
+    {
+        val = other.val;
+        copied++;
+        return *this;
+    }
+    tracked& operator=(tracked&& other) noexcept
+    {
+        val = other.val;
+        other.val = -1;
+        moved++;
+        return *this;
+    }
+};
+
+/**
+ * whether the keys of map are keys in order
+ */
+template <class Map>
+bool in_order(Map& map, std::initializer_list<int> keys)
+{
+    typename Map::iterator it = map.begin();
+    for (int key : keys) {
+        if (it == map.end() || it->first.val != key)
+            return false;
+        ++it;
+    }
+    return it == map.end();
+}
+
+void emplace_tester()
+{
+    std::cout << c[2];
+    using tmap = sjtu::linked_hashmap<Integer, tracked, Hash, Equal>;
+    tmap map;
+    // the value is built in its node, neither copied nor moved
+    bool ok = map.try_emplace(Integer(1), 10, 1).second && map.at(1).val == 11;
+    ok &= map.emplace(Integer(2), 20).second && map.try_emplace(Integer(3), 30).second;
+    ok &= built == 3 && copied == 0;
+    // a found key keeps its value and its place, a try_emplace leaves its args alone
+    tracked spare(99);
+    ok &= !map.try_emplace(Integer(1), std::move(spare)).second && spare.val == 99;
+    ok &= !map.emplace(Integer(1), 12).second && map.at(1).val == 11;
+    ok &= in_order(map, {1, 2, 3}) && copied == 0;
+    // insert_or_assign assigns a found value and moves it to the back
+    moved = 0;
+    auto res = map.insert_or_assign(Integer(1), std::move(spare));
+    ok &= !res.second && res.first->second.val == 99 && spare.val == -1 && moved == 1;
+    ok &= map.insert_or_assign(Integer(4), tracked(40)).second && map.at(4).val == 40;
+    ok &= in_order(map, {2, 3, 1, 4}) && copied == 0 && map.size() == 4;
+    result(ok);
+}
+
+int main()
+{
+#ifdef _OUTPUT_
+    freopen("22.out", "w", stdout);
+#endif
+    emplace_tester();
+    std::cout << c[3] << std::endl;
+}
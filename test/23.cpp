@@ -0,0 +1,83 @@
+#include "src.hpp"
+#if defined(_UNORDERED_MAP_) || (defined(_LIST_)) || (defined(_MAP_)) || (defined(_SET_)) || (defined(_UNORDERED_SET_)) || (defined(_GLIBCXX_MAP)) || (defined(_GLIBCXX_UNORDERED_MAP))
+BOOM :)
+#endif
+#include <initializer_list>
+#include <iostream>
+#include <string>
+
+std::string c[]={
+    "   pass!",
+    "   error.",
+    "test1: touch and move_to_back only relink",
+    "Congratulations. Your submission has passed all correctness tests. Good job! :)",
+};
+
+using lmap = sjtu::linked_hashmap<Integer, int, Hash, Equal>;
+
+void result(bool ok)
+{
+    std::cout << (ok ? c[0] : c[1]) << std::endl;
+}
+
+/**
+ * whether the keys of map are keys in order
+ */
+template <class Map>
+bool in_order(Map& map, std::initializer_list<int> keys)
+{
+    typename Map::iterator it = map.begin();
+    for (int key : keys) {
+        if (it == map.end() || it->first.val != key)
+            return false;
+        ++it;
+    }
+    return it == map.end();
+}
+
+void touch_tester()
+{
+    std::cout << c[2];
+    lmap map;
+    for (int i = 0; i < 5; i++)
+        map.insert(lmap::value_type(Integer(i), i));
+    size_t allocations = map.map.pool.allocations;
+    lmap::value_type* node = &*map.find(1);
+    bool ok = map.touch(Integer(1)) != map.end() && map.touch(3) != map.end();
+    ok &= map.touch(9) == map.end() && map.touch(Integer(4)) != map.end();
+    ok &= in_order(map, {0, 2, 1, 3, 4});
+    map.move_to_back(map.begin());
+    ok &= in_order(map, {2, 1, 3, 4, 0}) && &*map.find(1) == node;
+    ok &= map.map.pool.allocations == allocations && map.at(1) == 1;
+    try {
+        map.move_to_back(map.end());
+        ok = false;
+    } catch (sjtu::invalid_iterator&) {
+    }
+    sjtu::double_list<int> list;
+    for (int i = 0; i < 4; i++)
+        list.insert_tail(i);
+    allocations = list.pool.allocations;
+    list.move_to_tail(++list.begin());
+    list.move_to_tail(list.begin());
+    list.move_to_tail(list.last());
+    int expect[] = {2, 3, 1, 0}, k = 0;
+    for (sjtu::double_list<int>::iterator it = list.begin(); it != list.end(); ++it)
+        ok &= k < 4 && *it == expect[k++];
+    ok &= k == 4 && list.pool.allocations == allocations;
+    try {
+        list.move_to_tail(list.end());
+        ok = false;
+    } catch (sjtu::invalid_iterator&) {
+    }
+    result(ok);
+}
+
+int main()
+{
+#ifdef _OUTPUT_
+    freopen("23.out", "w", stdout);
+#endif
+    touch_tester();
+    std::cout << c[3] << std::endl;
+}
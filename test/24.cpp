@@ -0,0 +1,79 @@
+#include "src.hpp"
+#if defined(_UNORDERED_MAP_) || (defined(_LIST_)) || (defined(_MAP_)) || (defined(_SET_)) || (defined(_UNORDERED_SET_)) || (defined(_GLIBCXX_MAP)) || (defined(_GLIBCXX_UNORDERED_MAP))
+BOOM :)
+#endif
+#include <iostream>
+#include <string>
+
+std::string c[]={
+    "   pass!",
+    "   error.",
+    "test1: reserve, rehash and max_load_factor",
+    "Congratulations. Your submission has passed all correctness tests. Good job! :)",
+};
+
+using map_type = sjtu::hashmap<int, int>;
+
+void result(bool ok)
+{
+    std::cout << (ok ? c[0] : c[1]) << std::endl;
+}
+
+/**
+ * whether the keys [first, last) are found with value key * 2
+ */
+bool holds(const map_type& map, int first, int last)
+{
+    bool ok = true;
+    for (int i = first; i < last; i++) {
+        map_type::iterator it = map.find(i);
+        ok &= it != map.end() && it->second == i * 2;
+    }
+    return ok;
+}
+
+void fill(map_type& map, int first, int last)
+{
+    for (int i = first; i < last; i++)
+        map.insert(map_type::value_type(i, i * 2));
+}
+
+void reserve_tester()
+{
+    std::cout << c[2];
+    map_type map(1000);
+    bool ok = map.bucket_count() == 1024;
+    fill(map, 0, 1000);
+    ok &= map.bucket_count() == 1024 && map.old_table == nullptr;
+    map.rehash(5000);
+    ok &= map.bucket_count() == 8192 && map.old_table == nullptr && holds(map, 0, 1000);
+    // never fewer buckets than the elements need
+    map.rehash(1);
+    ok &= map.bucket_count() == 1024 && holds(map, 0, 1000);
+    try {
+        map.max_load_factor(0);
+        ok = false;
+    } catch (sjtu::runtime_error&) {
+    }
+    map.max_load_factor(4);
+    map.reserve(1000);
+    ok &= map.max_load_factor() == 4 && map.bucket_count() == 256 && holds(map, 0, 1000);
+    fill(map, 1000, 1025);
+    ok &= map.bucket_count() == 512 && holds(map, 0, 1025);
+    // the index of a cache is sized for its capacity up front
+    sjtu::lru cache(1000);
+    size_t buckets = cache.map.bucket_count();
+    for (int i = 0; i < 5000; i++)
+        cache.save(sjtu::pair<const Integer, Matrix<int>>(Integer(i), Matrix<int>(1, 1, i)));
+    ok &= buckets >= 1001 && cache.map.bucket_count() == buckets && cache.map.size() == 1000;
+    result(ok);
+}
+
+int main()
+{
+#ifdef _OUTPUT_
+    freopen("24.out", "w", stdout);
+#endif
+    reserve_tester();
+    std::cout << c[3] << std::endl;
+}
@@ -0,0 +1,71 @@
+#include "src.hpp"
+#if defined(_UNORDERED_MAP_) || (defined(_LIST_)) || (defined(_MAP_)) || (defined(_SET_)) || (defined(_UNORDERED_SET_)) || (defined(_GLIBCXX_MAP)) || (defined(_GLIBCXX_UNORDERED_MAP))
+BOOM :)
+#endif
+#include <iostream>
+#include <string>
+#include <vector>
+
+std::string c[]={
+    "   pass!",
+    "   error.",
+    "test1: get_many and save_many",
+    "Congratulations. Your submission has passed all correctness tests. Good job! :)",
+};
+
+void result(bool ok)
+{
+    std::cout << (ok ? c[0] : c[1]) << std::endl;
+}
+
+void batch_tester()
+{
+    std::cout << c[2];
+    using value_type = sjtu::pair<const Integer, Matrix<int>>;
+    sjtu::lru batched(100), single(100);
+    std::vector<value_type> values;
+    for (int i = 0; i < 150; i++)
+        values.push_back(value_type(Integer(i), Matrix<int>(2, 2, i)));
+    batched.save_many(values.begin(), values.end());
+    for (size_t i = 0; i < values.size(); i++)
+        single.save(values[i]);
+    // a range of std::move_iterator moves the matrices in
+    std::vector<value_type> more;
+    for (int i = 150; i < 160; i++)
+        more.push_back(value_type(Integer(i), Matrix<int>(2, 2, i)));
+    for (size_t i = 0; i < more.size(); i++)
+        single.save(more[i]);
+    batched.save_many(std::make_move_iterator(more.begin()), std::make_move_iterator(more.end()));
+    bool ok = batched.get(155) != nullptr && *batched.get(155) == Matrix<int>(2, 2, 155);
+    ok &= more[5].second.RowSize() == 0;
+    single.get(155);
+    single.get(155);
+    // hits, misses and the order left behind are those of single gets
+    int keys[40];
+    Matrix<int>* out[40];
+    for (int i = 0; i < 40; i++)
+        keys[i] = (i * 37) % 170;
+    batched.get_many(keys, 40, out);
+    for (int i = 0; i < 40; i++) {
+        Matrix<int>* m = single.get(keys[i]);
+        ok &= (m == nullptr) == (out[i] == nullptr) && (m == nullptr || *m == *out[i]);
+    }
+    for (int i = 0; i < 200; i++) {
+        Matrix<int>* m = single.get(i);
+        ok &= (m == nullptr) == (batched.get(i) == nullptr);
+    }
+    auto it = single.map.begin();
+    for (auto jt = batched.map.begin(); jt != batched.map.end(); ++jt, ++it)
+        ok &= it != single.map.end() && it->first.val == jt->first.val;
+    ok &= it == single.map.end();
+    result(ok);
+}
+
+int main()
+{
+#ifdef _OUTPUT_
+    freopen("25.out", "w", stdout);
+#endif
+    batch_tester();
+    std::cout << c[3] << std::endl;
+}
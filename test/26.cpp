@@ -0,0 +1,121 @@
+#include "src.hpp"
+#if defined(_UNORDERED_MAP_) || (defined(_LIST_)) || (defined(_MAP_)) || (defined(_SET_)) || (defined(_UNORDERED_SET_)) || (defined(_GLIBCXX_MAP)) || (defined(_GLIBCXX_UNORDERED_MAP))
+BOOM :)
+#endif
+#include <initializer_list>
+#include <iostream>
+#include <string>
+
+std::string c[]={
+    "   pass!",
+    "   error.",
+    "test1: move and swap hand the nodes over",
+    "test2: a moved-from lru or list is filled again",
+    "Congratulations. Your submission has passed all correctness tests. Good job! :)",
+};
+
+using lmap = sjtu::linked_hashmap<Integer, int, Hash, Equal>;
+
+void result(bool ok)
+{
+    std::cout << (ok ? c[0] : c[1]) << std::endl;
+}
+
+/**
+ * whether the keys of map are keys in order
+ */
+template <class Map>
+bool in_order(Map& map, std::initializer_list<int> keys)
+{
+    typename Map::iterator it = map.begin();
+    for (int key : keys) {
+        if (it == map.end() || it->first.val != key)
+            return false;
+        ++it;
+    }
+    return it == map.end();
+}
+
+void move_tester()
+{
+    std::cout << c[2];
+    using hmap = sjtu::hashmap<int, int>;
+    hmap a;
+    for (int i = 0; i < 1000; i++)
+        a.insert(hmap::value_type(i, i));
+    hmap::value_type* node = &*a.find(7);
+    size_t allocations = a.pool.allocations;
+    hmap b(std::move(a));
+    // the moved-from map holds no table and no slab, and can be used again
+    bool ok = &*b.find(7) == node && b.pool.allocations == allocations && b.elements == 1000;
+    ok &= a.empty() && a.bucket_count() == 1 && a.pool.slabs == nullptr && a.find(7) == a.end();
+    a.insert(hmap::value_type(1, 2));
+    ok &= a.find(1)->second == 2 && !a.remove(7);
+    a = std::move(b);
+    ok &= &*a.find(7) == node && a.elements == 1000 && b.empty() && b.find(7) == b.end();
+    a.swap(b);
+    ok &= &*b.find(7) == node && a.empty();
+    // linked_hashmap keeps its order, its nodes and the end of the list
+    lmap l;
+    for (int i = 0; i < 5; i++)
+        l.insert(lmap::value_type(Integer(i), i));
+    lmap::value_type* first = &*l.begin();
+    lmap m(std::move(l));
+    ok &= &*m.begin() == first && in_order(m, {0, 1, 2, 3, 4}) && l.empty() && l.begin() == l.end();
+    l.insert(lmap::value_type(Integer(9), 9));
+    m.move_to_back(m.begin());
+    ok &= in_order(l, {9}) && in_order(m, {1, 2, 3, 4, 0});
+    l.swap(m);
+    l.insert(lmap::value_type(Integer(5), 5));
+    ok &= in_order(l, {1, 2, 3, 4, 0, 5}) && in_order(m, {9});
+    m = std::move(l);
+    ok &= in_order(m, {1, 2, 3, 4, 0, 5}) && l.empty();
+    // a matrix in an lru stays where it is
+    sjtu::lru cache(10);
+    cache.save(sjtu::pair<const Integer, Matrix<int>>(Integer(3), Matrix<int>(2, 2, 3)));
+    Matrix<int>* matrix = cache.get(3);
+    sjtu::lru moved(std::move(cache));
+    ok &= moved.get(3) == matrix && cache.get(3) == nullptr;
+    cache = std::move(moved);
+    ok &= cache.get(3) == matrix;
+    result(ok);
+}
+
+void refill_tester()
+{
+    std::cout << c[3];
+    using value_type = sjtu::pair<const Integer, Matrix<int>>;
+    sjtu::lru a(2);
+    a.save(value_type(Integer(1), Matrix<int>(1, 1, 1)));
+    a.save(value_type(Integer(2), Matrix<int>(1, 1, 2)));
+    sjtu::lru b(std::move(a));
+    bool ok = b.weight == 2 && a.weight == 0 && a.map.size() == 0;
+    a.save(value_type(Integer(3), Matrix<int>(1, 1, 3)));
+    a.save(value_type(Integer(4), Matrix<int>(1, 1, 4)));
+    ok &= a.get(3) != nullptr && a.get(4) != nullptr && a.map.size() == 2 && a.weight == 2;
+    ok &= b.get(1) != nullptr && b.get(2) != nullptr;
+    b = std::move(a);
+    a.save(value_type(Integer(5), Matrix<int>(1, 1, 5)));
+    ok &= a.get(5) != nullptr && b.get(3) != nullptr && b.get(1) == nullptr;
+    sjtu::double_list<int> list;
+    list.insert_tail(1);
+    sjtu::double_list<int> other(std::move(list));
+    list.insert_tail(2);
+    list.insert_head(3);
+    ok &= *list.begin() == 3 && *other.begin() == 1;
+    other = std::move(list);
+    other.insert_tail(4);
+    list.insert_tail(5);
+    ok &= *other.begin() == 3 && *other.last() == 4 && *list.begin() == 5;
+    result(ok);
+}
+
+int main()
+{
+#ifdef _OUTPUT_
+    freopen("26.out", "w", stdout);
+#endif
+    move_tester();
+    refill_tester();
+    std::cout << c[4] << std::endl;
+}
@@ -0,0 +1,178 @@
+#include "src.hpp"
+#if defined(_UNORDERED_MAP_) || (defined(_LIST_)) || (defined(_MAP_)) || (defined(_SET_)) || (defined(_UNORDERED_SET_)) || (defined(_GLIBCXX_MAP)) || (defined(_GLIBCXX_UNORDERED_MAP))
+BOOM :)
+#endif
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+std::string c[]={
+    "   pass!",
+    "   error.",
+    "test1: a farther key takes the slot of a nearer one",
+    "test2: remove shifts the run back",
+    "test3: every key stays at its probe distance",
+    "test4: memcheck",
+    "Congratulations. Your submission has passed all correctness tests. Good job! :)",
+};
+
+using map_type = sjtu::robin_hashmap<int, int>;
+
+void result(bool ok)
+{
+    std::cout << (ok ? c[0] : c[1]) << std::endl;
+}
+
+/**
+ * the slot a probe for key starts from
+ */
+size_t home(const map_type& map, int key)
+{
+    return sjtu::hash_mix(std::hash<int>()(key)) & map.mask;
+}
+
+/**
+ * the slot key is in
+ */
+size_t slot(const map_type& map, int key)
+{
+    return map.find(key).at() - map.table;
+}
+
+/**
+ * the next key from first whose probe starts from slot s
+ */
+int key_of(const map_type& map, size_t s, int first = 0)
+{
+    int key = first;
+    while (home(map, key) != s)
+        key++;
+    return key;
+}
+
+/**
+ * whether every slot holds the distance of its key from home,
+ * and no key is farther than one more than the slot before it
+ * (so an empty slot is never followed by a displaced key)
+ */
+bool consistent(const map_type& map)
+{
+    bool ok = true;
+    size_t count = 0;
+    for (size_t i = 0; i <= map.mask; i++) {
+        size_t dist = map.table[i].dist;
+        if (dist != 0) {
+            ok &= ((i - home(map, map.table[i].val()->first)) & map.mask) + 1 == dist;
+            count++;
+        }
+        ok &= map.table[(i + 1) & map.mask].dist <= dist + 1;
+    }
+    return ok && count == map.elements;
+}
+
+void displace_tester()
+{
+    std::cout << c[2];
+    map_type map;
+    // a and b start from slot 5, d from slot 6
+    int a = key_of(map, 5), b = key_of(map, 5, a + 1), d = key_of(map, 6);
+    map.insert(map_type::value_type(a, 1));
+    map.insert(map_type::value_type(d, 2));
+    bool ok = slot(map, a) == 5 && slot(map, d) == 6;
+    // b is 2 from home at slot 6, d only 1, so d moves on
+    map.insert(map_type::value_type(b, 3));
+    ok &= map.mask == 7 && slot(map, a) == 5 && slot(map, b) == 6 && slot(map, d) == 7;
+    ok &= map.table[6].dist == 2 && map.table[7].dist == 2;
+    ok &= map.find(a)->second == 1 && map.find(b)->second == 3 && map.find(d)->second == 2;
+    ok &= consistent(map);
+    result(ok);
+}
+
+void shift_tester()
+{
+    std::cout << c[3];
+    map_type map;
+    int a = key_of(map, 5), b = key_of(map, 5, a + 1), d = key_of(map, 6);
+    map.insert(map_type::value_type(a, 1));
+    map.insert(map_type::value_type(b, 3));
+    map.insert(map_type::value_type(d, 2));
+    // no tombstone: b and d move one slot back towards their homes
+    map.remove(a);
+    bool ok = slot(map, b) == 5 && slot(map, d) == 6 && map.table[7].dist == 0;
+    ok &= map.table[5].dist == 1 && map.table[6].dist == 1 && map.find(a) == map.end();
+    // a key at its home stops the shift
+    map.remove(b);
+    ok &= map.table[5].dist == 0 && slot(map, d) == 6 && map.find(d)->second == 2;
+    ok &= map.elements == 1 && consistent(map);
+    result(ok);
+}
+
+void invariant_tester()
+{
+    std::cout << c[4];
+    map_type map;
+    const int range = 3000;
+    std::vector<int> ref(range, -1);
+    size_t elements = 0;
+    std::mt19937 rng(20240311);
+    bool ok = true;
+    for (int i = 0; i < 60000; i++) {
+        int key = rng() % range;
+        if (rng() % 2 == 0) {
+            ok &= map.insert(map_type::value_type(key, i)).second == (ref[key] == -1);
+            elements += ref[key] == -1;
+            ref[key] = i;
+        } else {
+            ok &= map.remove(key) == (ref[key] != -1);
+            elements -= ref[key] != -1;
+            ref[key] = -1;
+        }
+        if (i % 97 == 0)
+            ok &= consistent(map);
+    }
+    ok &= consistent(map) && map.elements == elements;
+    for (int key = 0; key < range; key++) {
+        map_type::iterator it = map.find(key);
+        ok &= ref[key] == -1 ? it == map.end() : it != map.end() && it->second == ref[key];
+    }
+    result(ok);
+}
+
+void memcheck_tester()
+{
+    std::cout << c[5];
+    using mp = sjtu::robin_hashmap<Integer, Matrix<int>, Hash, Equal>;
+    using value_type = sjtu::pair<Integer, Matrix<int>>;
+    bool ok = true;
+    {
+        mp map;
+        for (int i = 0; i < 3000; i++)
+            map.insert(value_type(Integer(i), Matrix<int>(1, 2, i)));
+        for (int i = 0; i < 3000; i += 2)
+            map.remove(Integer(i));
+        mp copy(map);
+        for (int i = 0; i < 3000; i++) {
+            mp::iterator it = copy.find(Integer(i));
+            ok &= (it == copy.end()) == (i % 2 == 0);
+            ok &= it == copy.end() || it->second == Matrix<int>(1, 2, i);
+        }
+        map = copy;
+        map.clear();
+        map.insert(value_type(Integer(1), Matrix<int>(1, 1, 1)));
+    }
+    ok &= Integer::counter == 0;
+    result(ok);
+}
+
+int main()
+{
+#ifdef _OUTPUT_
+    freopen("9.out", "w", stdout);
+#endif
+    displace_tester();
+    shift_tester();
+    invariant_tester();
+    memcheck_tester();
+    std::cout << c[6] << std::endl;
+}